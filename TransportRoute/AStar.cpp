@@ -0,0 +1 @@
+#include "AStar.h"
@@ -0,0 +1,130 @@
+#pragma once
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <algorithm>
+#include "Result.h"
+#include "Station.h"
+#include "GraphView.h"
+#include "SearchWorkspace.h"
+#include "Dijkstra.h"
+
+namespace transport {
+
+    // h(v) = costPerDistance * distancia euclidea (x,y) de v al destino.
+    // Solo se usa si es consistente (w(u,v) >= h(u) - h(v) en toda arista), lo que la hace admisible;
+    // si no, AStar cae a Dijkstra.
+    class GeoHeuristic {
+    public:
+        std::vector<double> x, y;          // por slot de Graph
+        double requestedFactor = 0.0;      // configurado (<= 0: calibrar)
+        double costPerDistance = 0.0;      // factor efectivo
+        double maxConsistentFactor = 0.0;  // mayor factor consistente con los pesos actuales
+        bool complete = false;             // todos los vertices tienen coordenadas
+        bool valid = false;
+        std::uint64_t checkedVersion = 0;  // Graph::version() de la ultima verificacion
+
+        // costPerDistance <= 0: usar maxConsistentFactor (calibrado con los pesos)
+        static GeoHeuristic build(const Graph& g, const std::vector<Station>& stations, double costPerDistance) {
+            GeoHeuristic h;
+            h.requestedFactor = costPerDistance;
+            int n = g.vertexCount();
+            h.x.assign(n, 0.0);
+            h.y.assign(n, 0.0);
+            std::vector<char> has(n, 0);
+            for (const auto& s : stations) {
+                int i = g.indexOf(s.id);
+                if (i < 0) continue;
+                h.x[i] = s.x; h.y[i] = s.y; has[i] = 1;
+            }
+            // vertices sin coordenadas: no hay cota fiable
+            h.complete = std::all_of(has.begin(), has.end(), [](char c) { return c != 0; });
+            h.check(g);
+            return h;
+        }
+
+        // max speed -> costo por unidad de distancia
+        static double factorFromMaxSpeed(double maxSpeed) { return maxSpeed > 0.0 ? 1.0 / maxSpeed : 0.0; }
+
+        // verifica consistencia contra todas las aristas (tambien cerradas, asi reabrir no la rompe)
+        bool check(const Graph& g) {
+            checkedVersion = g.version();
+            int n = g.vertexCount();
+            if ((int)x.size() != n) { valid = false; return false; }
+            double best = std::numeric_limits<double>::infinity();
+            for (int u = 0; u < n; ++u) {
+                for (const auto& e : g.neighborsAt(u)) {
+                    double d = euclid(u, e.slot);
+                    if (d > 0.0) best = std::min(best, e.w / d);
+                    else if (e.w < 0.0) best = 0.0;
+                }
+            }
+            maxConsistentFactor = std::isinf(best) ? 0.0 : std::max(best, 0.0);
+            costPerDistance = requestedFactor > 0.0 ? requestedFactor : maxConsistentFactor;
+            valid = complete && costPerDistance > 0.0 && costPerDistance <= maxConsistentFactor * (1.0 + 1e-12);
+            return valid;
+        }
+
+        bool validFor(const Graph& g) const { return valid && checkedVersion == g.version(); }
+        bool validFor(const CsrGraph& g) const { return valid && checkedVersion == g.sourceVersion; }
+
+        double euclid(int u, int v) const { return std::hypot(x[u] - x[v], y[u] - y[v]); }
+        double estimate(int v, int target) const { return costPerDistance * euclid(v, target); }
+    };
+
+    class AStar {
+        template <typename G>
+        static PathResult shortestPathIndexed(const G& g, int srcId, int dstId, const GeoHeuristic& h, SearchWorkspace& ws) {
+            PathResult res; res.algo = "AStar";
+            int src = g.indexOf(srcId), dst = g.indexOf(dstId);
+            if (src < 0 || dst < 0) return res;
+
+            ws.reset(g.vertexCount());
+            auto& pq = ws.heap; // clave = g + h
+            ws.set(src, 0.0, -1);
+            pq.pushOrDecrease(src, h.estimate(src, dst));
+
+            while (!pq.empty()) {
+                int u = pq.pop().second;
+                ws.settle(u);
+                if (u == dst) break;
+                double du = ws.dist(u);
+                forEachOpenNeighborAt(g, u, [&](int v, double w) {
+                    double nd = du + w;
+                    if (!ws.settled(v) && nd < ws.dist(v)) {
+                        ws.set(v, nd, u);
+                        pq.pushOrDecrease(v, nd + h.estimate(v, dst));
+                    }
+                    });
+            }
+
+            if (!ws.reached(dst)) return res; // unreachable
+
+            res.reachable = true;
+            res.cost = ws.dist(dst);
+            for (int cur = dst; ; cur = ws.parent(cur)) {
+                res.path.push_back(g.idAt(cur));
+                if (cur == src) break;
+            }
+            std::reverse(res.path.begin(), res.path.end());
+            return res;
+        }
+
+        template <typename G>
+        static PathResult dispatch(const G& g, int src, int dst, const GeoHeuristic& h, SearchWorkspace& ws) {
+            if (!h.validFor(g)) {
+                auto r = Dijkstra::shortestPath(g, src, dst, ws);
+                r.algo = "AStar->Dijkstra"; // heuristica no valida para este grafo
+                return r;
+            }
+            return shortestPathIndexed(g, src, dst, h, ws);
+        }
+    public:
+        static PathResult shortestPath(const Graph& g, int src, int dst, const GeoHeuristic& h) { SearchWorkspace ws; return dispatch(g, src, dst, h, ws); }
+        static PathResult shortestPath(const CsrGraph& g, int src, int dst, const GeoHeuristic& h) { SearchWorkspace ws; return dispatch(g, src, dst, h, ws); }
+        static PathResult shortestPath(const Graph& g, int src, int dst, const GeoHeuristic& h, SearchWorkspace& ws) { return dispatch(g, src, dst, h, ws); }
+        static PathResult shortestPath(const CsrGraph& g, int src, int dst, const GeoHeuristic& h, SearchWorkspace& ws) { return dispatch(g, src, dst, h, ws); }
+    };
+
+} // namespace transport
@@ -12,11 +12,8 @@ namespace transport {
             std::stringstream ss(line); int u, v; double delta;
             if (!(ss >> u >> v >> delta)) continue;
 
-            // ajustar en ambas listas
-            auto& du = const_cast<std::vector<Graph::AdjEdge>&>(g.neighbors(u));
-            for (auto& e : du) if (e.to == v && !e.closed) { e.w += delta; any = true; }
-            auto& dv = const_cast<std::vector<Graph::AdjEdge>&>(g.neighbors(v));
-            for (auto& e : dv) if (e.to == u && !e.closed) { e.w += delta; any = true; }
+            // ajustar en ambas listas (via Graph para que cambie version())
+            any = g.adjustWeight(u, v, delta) || any;
         }
         return any;
     }
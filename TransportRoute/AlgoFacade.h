@@ -1,10 +1,26 @@
 #pragma once
+#include <optional>
 #include "Graph.h"
+#include "CsrGraph.h"
+#include "SearchWorkspace.h"
 #include "Result.h"
 #include "BFS.h"
 #include "DFS.h"
 #include "Dijkstra.h"
+#include "AStar.h"
+#include "Alt.h"
+#include "ContractionHierarchy.h"
+#include "Crp.h"
 #include "FloydWarshall.h"
+#include "CompactAllPairs.h"
+#include "HubLabels.h"
+#include "LazyAllPairs.h"
+#include "QueryPlanner.h"
+#include "DistanceTable.h"
+#include "NearestFacility.h"
+#include "Isochrone.h"
+#include "KShortestPaths.h"
+#include "Biconnectivity.h"
 #include "Prim.h"
 #include "Kruskal.h"
 
@@ -12,16 +28,138 @@ namespace transport {
 
     class AlgoFacade {
     public:
+        // elige el motor segun tamano, densidad, cambios, caches listas y patron de consulta
+        static QueryPlanner::Plan plan(const QueryPlanner::Input& in) { return QueryPlanner::plan(in); }
+
+        // rechazo inmediato de pares sin camino (indice de conectividad de Graph)
+        static bool connected(const Graph& g, int u, int v) { return g.connected(u, v); }
+
         static VisitResult runBFS(const Graph& g, int start) { return BFS::traverse(g, start); }
         static VisitResult runDFS(const Graph& g, int start) { return DFS::traverse(g, start); }
         static PathResult runDijkstra(const Graph& g, int src, int dst) { return Dijkstra::shortestPath(g, src, dst); }
+        static PathResult runBidirectionalDijkstra(const Graph& g, int src, int dst) { return Dijkstra::bidirectional(g, src, dst); }
+
+        // A*: cae a Dijkstra si la heuristica no es consistente con el grafo actual
+        static PathResult runAStar(const Graph& g, int src, int dst, const GeoHeuristic& h) { return AStar::shortestPath(g, src, dst, h); }
+
+        // ALT: preprocesar landmarks una vez; los cierres no invalidan las tablas
+        static ALT::Index preprocessALT(const Graph& g, int landmarks, ALT::LandmarkStrategy s = ALT::LandmarkStrategy::Farthest) {
+            return ALT::preprocess(g, landmarks, s);
+        }
+        static PathResult runALT(const Graph& g, const ALT::Index& idx, int src, int dst) { return ALT::shortestPath(g, idx, src, dst); }
 
-        // Floyd: computar una vez y reusar (UI puede cachear)
-        static FloydWarshall::AllPairs computeFloyd(const Graph& g) { return FloydWarshall::compute(g); }
+        // CH: preprocesar cuando cambia la topologia; los cierres se verifican en la consulta
+        static CH::Hierarchy preprocessCH(const Graph& g) { return CH::preprocess(g); }
+        static PathResult runCH(const Graph& g, const CH::Hierarchy& h, int src, int dst) { return CH::shortestPath(g, h, src, dst); }
+
+        // CRP: particion una vez; customizar (incremental) despues de cada lote de cambios
+        static CRP::Partition partitionCRP(const Graph& g) { return CRP::partition(g); }
+        static int customizeCRP(const Graph& g, const CRP::Partition& p, CRP::Metric& m) { return CRP::customize(g, p, m); }
+        static PathResult runCRP(const Graph& g, const CRP::Partition& p, const CRP::Metric& m, int src, int dst) { return CRP::shortestPath(g, p, m, src, dst); }
+
+        // Floyd: computar una vez y reusar (UI puede cachear). Todo lo que arma NxN pide el
+        // presupuesto de memoria y devuelve null si la matriz no entra (ver QueryPlanner::matrixBytes)
+        static std::optional<FloydWarshall::AllPairs> computeFloyd(const Graph& g, size_t memoryBudgetBytes) {
+            if (!matrixFits(g.vertexCount(), memoryBudgetBytes)) return std::nullopt;
+            return FloydWarshall::compute(g);
+        }
         static PathResult runFloyd(const FloydWarshall::AllPairs& ap, int src, int dst) { return ap.path(src, dst); }
+        // compacta: camino por 'next', costo exacto sumado sobre g
+        static PathResult runFloyd(const CompactAllPairs& ap, const Graph& g, int src, int dst) { return ap.path(src, dst, g); }
+
+        // hub labels: alternativa a Floyd sin matriz NxN (distancias exactas, camino opcional)
+        static HubLabels::Index computeHubLabels(const Graph& g, bool withPaths = true) { return HubLabels::build(g, withPaths); }
+        static PathResult runHubLabels(const HubLabels::Index& idx, int src, int dst) { return idx.path(src, dst); }
+
+        // filas bajo demanda: un Dijkstra por origen nuevo, LRU con presupuesto de memoria
+        static PathResult runLazyAllPairs(LazyAllPairs& ap, int src, int dst) { return ap.path(src, dst); }
+
+        // matriz OD: un Dijkstra podado por origen, origenes en paralelo
+        static DistanceTable::Table runDistanceTable(const CsrGraph& g, const std::vector<int>& sources, const std::vector<int>& targets, bool withPaths = false) {
+            return DistanceTable::compute(g, sources, targets, withPaths);
+        }
+
+        // instalacion mas cercana para cada estacion (una pasada multi-fuente)
+        static NearestFacility::Partition runNearestFacility(const CsrGraph& g, const std::vector<int>& sources, SearchWorkspace& ws) {
+            return NearestFacility::compute(g, sources, ws);
+        }
+
+        // K alternativas sin ciclos (Yen), la primera es el camino minimo
+        static std::vector<PathResult> runKShortestPaths(const CsrGraph& g, int src, int dst, int k, SearchWorkspace& tree, SearchWorkspace& ws) {
+            return KShortestPaths::yen(g, src, dst, k, tree, ws);
+        }
+
+        // isocronas: alcanzable con costo/saltos acotados (corta al pasar el presupuesto)
+        static Isochrone::Reach runIsochrone(const Graph& g, int origin, const Isochrone::Limits& lim, SearchWorkspace& ws) {
+            return Isochrone::compute(g, origin, lim, ws);
+        }
+        static std::vector<Isochrone::Reach> runIsochrones(const Graph& g, const std::vector<int>& origins, const Isochrone::Limits& lim) {
+            return Isochrone::batch(g, origins, lim);
+        }
+
+        // puentes / articulaciones / componentes biconexas (una pasada, recalcular si cambia el grafo)
+        static Biconnectivity::Report analyzeCuts(const CsrGraph& g) { return Biconnectivity::analyze(g); }
 
         static MSTResult runPrim(const Graph& g, int start) { return Prim::mst(g, start); }
         static MSTResult runKruskal(const Graph& g) { return Kruskal::mst(g); }
+
+        // mismas consultas sobre una foto CSR (construir una vez, reusar mientras no cambie el grafo)
+        static CsrGraph snapshot(const Graph& g) { return CsrGraph::build(g); }
+        static VisitResult runBFS(const CsrGraph& g, int start) { return BFS::traverse(g, start); }
+        static VisitResult runDFS(const CsrGraph& g, int start) { return DFS::traverse(g, start); }
+        // saltos desde 'start' a cada estacion (BFS por niveles en paralelo)
+        static BFS::Levels runBFSLevels(const CsrGraph& g, int start) { return BFS::levels(g, start); }
+        // DFS con tiempos de descubrimiento/cierre y padres (todo el bosque si all = true)
+        static DFS::Forest runDFSForest(const CsrGraph& g, int start, bool all = false) { return all ? DFS::exploreAll(g, start) : DFS::explore(g, start); }
+        static PathResult runDijkstra(const CsrGraph& g, int src, int dst) { return Dijkstra::shortestPath(g, src, dst); }
+        static PathResult runBidirectionalDijkstra(const CsrGraph& g, int src, int dst) { return Dijkstra::bidirectional(g, src, dst); }
+        static std::optional<FloydWarshall::AllPairs> computeFloyd(const CsrGraph& g, size_t memoryBudgetBytes) {
+            if (!matrixFits(g.vertexCount(), memoryBudgetBytes)) return std::nullopt;
+            return FloydWarshall::compute(g);
+        }
+        static std::optional<FloydWarshall::AllPairs> computeAllPairsByDijkstra(const CsrGraph& g, size_t memoryBudgetBytes) {
+            if (!matrixFits(g.vertexCount(), memoryBudgetBytes)) return std::nullopt;
+            return FloydWarshall::computeByDijkstra(g);
+        }
+        // elige el motor por densidad: N Dijkstra si la red es rala, Floyd si no (null = rechazado)
+        static std::optional<FloydWarshall::AllPairs> computeAllPairs(const CsrGraph& g, size_t memoryBudgetBytes) {
+            if (!matrixFits(g.vertexCount(), memoryBudgetBytes)) return std::nullopt;
+            return FloydWarshall::preferDijkstra(g) ? FloydWarshall::computeByDijkstra(g) : FloydWarshall::compute(g);
+        }
+        static MSTResult runPrim(const CsrGraph& g, int start) { return Prim::mst(g, start); }
+        static MSTResult runKruskal(const CsrGraph& g) { return Kruskal::mst(g); }
+
+        // con workspace reutilizable (un SearchWorkspace por hilo; ver SearchWorkspace::forThisThread)
+        static VisitResult runBFS(const Graph& g, int start, SearchWorkspace& ws) { return BFS::traverse(g, start, ws); }
+        static VisitResult runBFS(const CsrGraph& g, int start, SearchWorkspace& ws) { return BFS::traverse(g, start, ws); }
+        static PathResult runDijkstra(const Graph& g, int src, int dst, SearchWorkspace& ws) { return Dijkstra::shortestPath(g, src, dst, ws); }
+        static PathResult runDijkstra(const CsrGraph& g, int src, int dst, SearchWorkspace& ws) { return Dijkstra::shortestPath(g, src, dst, ws); }
+        static PathResult runDijkstra(const Graph& g, int src, int dst, SearchWorkspace& ws, HeapKind heap, double radixScale = 1.0) {
+            return Dijkstra::shortestPath(g, src, dst, ws, heap, radixScale);
+        }
+        static PathResult runDijkstra(const CsrGraph& g, int src, int dst, SearchWorkspace& ws, HeapKind heap, double radixScale = 1.0) {
+            return Dijkstra::shortestPath(g, src, dst, ws, heap, radixScale);
+        }
+        static PathResult runBidirectionalDijkstra(const Graph& g, int src, int dst, SearchWorkspace& fw, SearchWorkspace& bw) {
+            return Dijkstra::bidirectional(g, src, dst, fw, bw);
+        }
+        static PathResult runBidirectionalDijkstra(const CsrGraph& g, int src, int dst, SearchWorkspace& fw, SearchWorkspace& bw) {
+            return Dijkstra::bidirectional(g, src, dst, fw, bw);
+        }
+        static PathResult runAStar(const Graph& g, int src, int dst, const GeoHeuristic& h, SearchWorkspace& ws) { return AStar::shortestPath(g, src, dst, h, ws); }
+        static PathResult runAStar(const CsrGraph& g, int src, int dst, const GeoHeuristic& h, SearchWorkspace& ws) { return AStar::shortestPath(g, src, dst, h, ws); }
+        static PathResult runALT(const Graph& g, const ALT::Index& idx, int src, int dst, SearchWorkspace& ws) { return ALT::shortestPath(g, idx, src, dst, ws); }
+        static PathResult runCH(const Graph& g, const CH::Hierarchy& h, int src, int dst, SearchWorkspace& fw, SearchWorkspace& bw) {
+            return CH::shortestPath(g, h, src, dst, fw, bw);
+        }
+        static PathResult runCRP(const Graph& g, const CRP::Partition& p, const CRP::Metric& m, int src, int dst, SearchWorkspace& fw, SearchWorkspace& bw) {
+            return CRP::shortestPath(g, p, m, src, dst, fw, bw);
+        }
+        static MSTResult runPrim(const Graph& g, int start, SearchWorkspace& ws) { return Prim::mst(g, start, ws); }
+        static MSTResult runPrim(const CsrGraph& g, int start, SearchWorkspace& ws) { return Prim::mst(g, start, ws); }
+
+    private:
+        static bool matrixFits(int n, size_t memoryBudgetBytes) { return QueryPlanner::matrixBytes(n) <= memoryBudgetBytes; }
     };
 
 } // namespace transport
@@ -0,0 +1 @@
+#include "Alt.h"
@@ -0,0 +1,217 @@
+#pragma once
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <algorithm>
+#include "Result.h"
+#include "GraphView.h"
+#include "SearchWorkspace.h"
+#include "Dijkstra.h"
+#include "Parallel.h"
+
+namespace transport {
+
+    // ALT: A* con cotas por landmarks y desigualdad triangular.
+    // h(v,t) = max_L |d(L,t) - d(L,v)| (grafo no dirigido). Cerrar aristas o subir pesos
+    // solo aumenta distancias, asi que las tablas siguen siendo cotas inferiores validas;
+    // solo hay que recalcularlas si cambia Graph::decreaseVersion().
+    class ALT {
+    public:
+        enum class LandmarkStrategy {
+            Farthest,   // cada landmark es el vertice mas lejano a los ya elegidos
+            Avoid       // Goldberg-Werneck: evita regiones ya bien cubiertas por las cotas
+        };
+
+        struct Index {
+            std::vector<int> landmarks;           // slots de Graph
+            std::vector<double> dist;             // N*K por vertice: dist[v*K + l] = d(landmark l, v)
+            int n = 0;
+            int k = 0;
+            std::uint64_t decreaseVersion = 0;    // Graph::decreaseVersion() al calcular las tablas
+
+            bool validFor(const Graph& g) const { return k > 0 && decreaseVersion == g.decreaseVersion(); }
+
+            // cota inferior de d(v,t); infinito si el landmark prueba que estan en componentes distintas
+            double lowerBound(int v, int t) const {
+                if (v >= n || t >= n) return 0.0; // vertice agregado despues: sin informacion
+                const double INF = std::numeric_limits<double>::infinity();
+                const double* dv = &dist[(size_t)v * k];
+                const double* dt = &dist[(size_t)t * k];
+                double h = 0.0;
+                for (int l = 0; l < k; ++l) {
+                    bool iv = std::isinf(dv[l]), it = std::isinf(dt[l]);
+                    if (iv != it) return INF;
+                    if (!iv) h = std::max(h, std::fabs(dv[l] - dt[l]));
+                }
+                return h;
+            }
+        };
+
+        // elige k landmarks y calcula sus tablas (threads <= 0: todos los nucleos)
+        static Index preprocess(const Graph& g, int k, LandmarkStrategy strategy = LandmarkStrategy::Farthest, int threads = 0) {
+            Index idx;
+            idx.n = g.vertexCount();
+            k = std::min(k, idx.n);
+            if (k <= 0) return idx;
+            idx.landmarks = strategy == LandmarkStrategy::Avoid ? selectAvoid(g, k) : selectFarthest(g, k);
+            refresh(g, idx, threads);
+            return idx;
+        }
+
+        // recalcula las tablas con los mismos landmarks (un Dijkstra por landmark, en paralelo)
+        static void refresh(const Graph& g, Index& idx, int threads = 0) {
+            const double INF = std::numeric_limits<double>::infinity();
+            int n = g.vertexCount(), k = (int)idx.landmarks.size();
+            std::vector<double> byLandmark((size_t)k * n, INF); // contiguo por landmark: sin false sharing
+            std::vector<SearchWorkspace> ws(workerCount(threads));
+            parallelFor(0, k, [&](int l, int w) {
+                Dijkstra::fullTree(g, idx.landmarks[l], ws[w]);
+                double* row = &byLandmark[(size_t)l * n];
+                for (int v : ws[w].queue) row[v] = ws[w].dist(v);
+                }, (int)ws.size());
+
+            idx.n = n; idx.k = k;
+            idx.dist.assign((size_t)n * k, INF);
+            for (int l = 0; l < k; ++l)
+                for (int v = 0; v < n; ++v) idx.dist[(size_t)v * k + l] = byLandmark[(size_t)l * n + v];
+            idx.decreaseVersion = g.decreaseVersion();
+        }
+
+        static PathResult shortestPath(const Graph& g, const Index& idx, int src, int dst) { SearchWorkspace ws; return dispatch(g, idx, src, dst, ws); }
+        static PathResult shortestPath(const Graph& g, const Index& idx, int src, int dst, SearchWorkspace& ws) { return dispatch(g, idx, src, dst, ws); }
+
+    private:
+        static PathResult dispatch(const Graph& g, const Index& idx, int srcId, int dstId, SearchWorkspace& ws) {
+            if (!idx.validFor(g)) {
+                auto r = Dijkstra::shortestPath(g, srcId, dstId, ws);
+                r.algo = "ALT->Dijkstra"; // hubo abaratamientos: las tablas ya no son cotas
+                return r;
+            }
+            PathResult res; res.algo = "ALT";
+            int src = g.indexOf(srcId), dst = g.indexOf(dstId);
+            if (src < 0 || dst < 0) return res;
+            if (std::isinf(idx.lowerBound(src, dst))) return res; // componentes distintas
+
+            ws.reset(g.vertexCount());
+            auto& pq = ws.heap; // clave = g + h
+            ws.set(src, 0.0, -1);
+            pq.pushOrDecrease(src, idx.lowerBound(src, dst));
+
+            while (!pq.empty()) {
+                int u = pq.pop().second;
+                ws.settle(u);
+                if (u == dst) break;
+                double du = ws.dist(u);
+                forEachOpenNeighborAt(g, u, [&](int v, double w) {
+                    double nd = du + w;
+                    if (!ws.settled(v) && nd < ws.dist(v)) {
+                        double h = idx.lowerBound(v, dst);
+                        if (std::isinf(h)) return;
+                        ws.set(v, nd, u);
+                        pq.pushOrDecrease(v, nd + h);
+                    }
+                    });
+            }
+
+            if (!ws.reached(dst)) return res; // unreachable
+
+            res.reachable = true;
+            res.cost = ws.dist(dst);
+            for (int cur = dst; ; cur = ws.parent(cur)) {
+                res.path.push_back(g.idAt(cur));
+                if (cur == src) break;
+            }
+            std::reverse(res.path.begin(), res.path.end());
+            return res;
+        }
+
+        // vertice mas lejano a los landmarks elegidos (no alcanzables cuentan como infinito)
+        static std::vector<int> selectFarthest(const Graph& g, int k) {
+            const double INF = std::numeric_limits<double>::infinity();
+            int n = g.vertexCount();
+            std::vector<int> out;
+            std::vector<double> minDist(n, INF);
+            std::vector<char> chosen(n, 0);
+            SearchWorkspace ws;
+
+            // el primero: el mas lejano desde el slot 0
+            Dijkstra::fullTree(g, 0, ws);
+            int next = ws.queue.back();
+            while ((int)out.size() < k) {
+                out.push_back(next); chosen[next] = 1;
+                Dijkstra::fullTree(g, next, ws);
+                for (int v = 0; v < n; ++v) minDist[v] = std::min(minDist[v], ws.dist(v));
+                next = -1;
+                double best = -1.0;
+                for (int v = 0; v < n; ++v) {
+                    if (chosen[v]) continue;
+                    double d = std::isinf(minDist[v]) ? std::numeric_limits<double>::max() : minDist[v];
+                    if (d > best) { best = d; next = v; }
+                }
+                if (next < 0) break;
+            }
+            return out;
+        }
+
+        // avoid: arbol desde una raiz, peso(v) = d(r,v) - cota(r,v); se baja por el subarbol
+        // de mayor peso acumulado que no contenga landmarks y su hoja es el nuevo landmark
+        static std::vector<int> selectAvoid(const Graph& g, int k) {
+            int n = g.vertexCount();
+            std::vector<int> out;
+            std::vector<std::vector<double>> tables; // d(landmark, v) de los elegidos
+            std::vector<char> chosen(n, 0);
+            std::vector<double> size(n);
+            std::vector<int> bestChild(n);
+            std::vector<char> blocked(n);
+            SearchWorkspace ws;
+            std::uint32_t seed = 2166136261u;
+
+            while ((int)out.size() < k) {
+                seed = seed * 1664525u + 1013904223u;
+                int root = (int)(seed % (std::uint32_t)n);
+                Dijkstra::fullTree(g, root, ws);
+                const auto order = ws.queue;
+
+                for (int v : order) {
+                    double lb = 0.0;
+                    for (const auto& t : tables) {
+                        if (!std::isinf(t[root]) && !std::isinf(t[v])) lb = std::max(lb, std::fabs(t[root] - t[v]));
+                    }
+                    size[v] = ws.dist(v) - lb;
+                    bestChild[v] = -1;
+                    blocked[v] = chosen[v];
+                }
+                // acumular de hojas a raiz
+                for (auto it = order.rbegin(); it != order.rend(); ++it) {
+                    int v = *it, p = ws.parent(v);
+                    if (blocked[v]) size[v] = 0.0;
+                    if (p < 0) continue;
+                    if (blocked[v]) blocked[p] = 1;
+                    size[p] += size[v];
+                    if (bestChild[p] < 0 || size[v] > size[bestChild[p]]) bestChild[p] = v;
+                }
+                int best = -1;
+                for (int v : order) if (!blocked[v] && (best < 0 || size[v] > size[best])) best = v;
+                if (best < 0 || size[best] <= 0.0) {
+                    // componente de la raiz ya cubierta: otra componente, o el libre mas lejano
+                    best = -1;
+                    for (int v = 0; v < n && best < 0; ++v) if (!chosen[v] && !ws.reached(v)) best = v;
+                    for (auto it = order.rbegin(); it != order.rend() && best < 0; ++it) if (!chosen[*it]) best = *it;
+                    if (best < 0) break;
+                }
+                else {
+                    while (bestChild[best] >= 0 && !blocked[bestChild[best]]) best = bestChild[best];
+                }
+
+                out.push_back(best); chosen[best] = 1;
+                Dijkstra::fullTree(g, best, ws);
+                std::vector<double> t(n);
+                for (int v = 0; v < n; ++v) t[v] = ws.dist(v);
+                tables.push_back(std::move(t));
+            }
+            return out;
+        }
+    };
+
+} // namespace transport
@@ -1,29 +1,140 @@
 #pragma once
-#include <queue>
-#include <unordered_map>
-#include <unordered_set>
+#include <vector>
+#include <atomic>
+#include <memory>
+#include <algorithm>
 #include "Result.h"
 #include "GraphView.h"
+#include "Parallel.h"
+#include "SearchWorkspace.h"
 
 namespace transport {
 
     class BFS {
     public:
-        static VisitResult traverse(const Graph& g, int start) {
+        // BFS por niveles: saltos (cantidad de tramos) desde el origen para cada estacion
+        struct Levels {
+            std::vector<int> order;                  // ids agrupados por nivel (dentro del nivel, por slot)
+            std::vector<int> levelStart;             // nivel L = order[levelStart[L], levelStart[L+1])
+            std::vector<int> hops;                   // slot -> saltos (-1 = no alcanzado)
+            std::vector<int> parent;                 // slot -> slot del nivel anterior (-1 = origen)
+            int bottomUpSteps = 0;                   // niveles hechos de abajo hacia arriba (diagnostico)
+
+            int depth() const { return levelStart.empty() ? 0 : (int)levelStart.size() - 1; }
+        };
+
+    private:
+        // G = Graph (por slot) o CsrGraph (por indice); ambos densos 0..N-1
+        template <typename G>
+        static VisitResult traverseIndexed(const G& g, int start, SearchWorkspace& ws) {
             VisitResult res; res.algo = "BFS";
-            if (!g.hasVertex(start)) return res;
-            std::unordered_set<int> vis;
-            std::queue<int> q;
-            vis.insert(start); q.push(start);
-            while (!q.empty()) {
-                int u = q.front(); q.pop();
-                res.order.push_back(u);
-                forEachOpenNeighbor(g, u, [&](int v, double) {
-                    if (!vis.count(v)) { vis.insert(v); q.push(v); }
+            int s = g.indexOf(start);
+            if (s < 0) return res;
+            ws.reset(g.vertexCount());
+            auto& q = ws.queue;
+            ws.settle(s); q.push_back(s);
+            for (size_t head = 0; head < q.size(); ++head) {
+                int u = q[head];
+                res.order.push_back(g.idAt(u));
+                forEachOpenNeighborAt(g, u, [&](int v, double) {
+                    if (!ws.settled(v)) { ws.settle(v); q.push_back(v); }
                     });
             }
             return res;
         }
+
+        static long long degreeAt(const Graph& g, int u) { return (long long)g.neighborsAt(u).size(); }
+        static long long degreeAt(const CsrGraph& g, int u) { return g.offsets[u + 1] - g.offsets[u]; }
+
+        // cambio de direccion (Beamer): abajo-arriba cuando las aristas de la frontera superan
+        // 1/Alpha de las que faltan explorar; arriba-abajo otra vez cuando la frontera baja de N/Beta
+        static constexpr long long Alpha = 14;
+        static constexpr long long Beta = 24;
+        static constexpr int Chunk = 1024;           // vertices por tarea
+
+        template <typename G>
+        static Levels levelsIndexed(const G& g, int start, int threads) {
+            int n = g.vertexCount();
+            Levels L;
+            L.hops.assign(n, -1);
+            L.parent.assign(n, -1);
+            int s = g.indexOf(start);
+            if (s < 0) return L;
+
+            std::unique_ptr<std::atomic<int>[]> hop(new std::atomic<int>[n]);
+            long long unexplored = 0;
+            for (int v = 0; v < n; ++v) { hop[v].store(-1, std::memory_order_relaxed); unexplored += degreeAt(g, v); }
+            hop[s].store(0, std::memory_order_relaxed);
+            unexplored -= degreeAt(g, s);
+
+            const int workers = workerCount(threads);
+            std::vector<std::vector<int>> local(workers);
+            std::vector<int> frontier{ s };
+            L.levelStart.push_back(0);
+            L.order.push_back(g.idAt(s));
+            bool bottomUp = false;
+            for (int level = 0; !frontier.empty(); ++level) {
+                long long frontierEdges = 0;
+                for (int u : frontier) frontierEdges += degreeAt(g, u);
+                if (!bottomUp && frontierEdges > unexplored / Alpha) bottomUp = true;
+                else if (bottomUp && (long long)frontier.size() < n / Beta) bottomUp = false;
+
+                for (auto& l : local) l.clear();
+                if (bottomUp) {
+                    // cada vertice sin nivel busca un vecino en la frontera; solo escribe el suyo
+                    ++L.bottomUpSteps;
+                    int chunks = (n + Chunk - 1) / Chunk;
+                    parallelFor(0, chunks, [&](int c, int w) {
+                        for (int v = c * Chunk, end = std::min(n, v + Chunk); v < end; ++v) {
+                            if (hop[v].load(std::memory_order_relaxed) != -1) continue;
+                            int cursor = 0, u;
+                            while (nextOpenNeighborAt(g, v, cursor, u)) {
+                                if (hop[u].load(std::memory_order_relaxed) != level) continue;
+                                hop[v].store(level + 1, std::memory_order_relaxed);
+                                L.parent[v] = u;
+                                local[w].push_back(v);
+                                break;
+                            }
+                        }
+                        }, workers);
+                }
+                else {
+                    // la frontera reclama vecinos con CAS: cada vertice entra una sola vez
+                    int chunks = ((int)frontier.size() + Chunk - 1) / Chunk;
+                    parallelFor(0, chunks, [&](int c, int w) {
+                        for (int i = c * Chunk, end = std::min((int)frontier.size(), i + Chunk); i < end; ++i) {
+                            int u = frontier[i];
+                            forEachOpenNeighborAt(g, u, [&](int v, double) {
+                                int expected = -1;
+                                if (hop[v].load(std::memory_order_relaxed) != -1) return;
+                                if (!hop[v].compare_exchange_strong(expected, level + 1, std::memory_order_relaxed)) return;
+                                L.parent[v] = u;
+                                local[w].push_back(v);
+                                });
+                        }
+                        }, frontierEdges < Chunk ? 1 : workers);
+                }
+
+                frontier.clear();
+                for (const auto& l : local) frontier.insert(frontier.end(), l.begin(), l.end());
+                std::sort(frontier.begin(), frontier.end()); // salida estable y mejor localidad
+                if (frontier.empty()) break;
+                L.levelStart.push_back((int)L.order.size());
+                for (int v : frontier) { unexplored -= degreeAt(g, v); L.order.push_back(g.idAt(v)); }
+            }
+            L.levelStart.push_back((int)L.order.size());
+            for (int v = 0; v < n; ++v) L.hops[v] = hop[v].load(std::memory_order_relaxed);
+            return L;
+        }
+    public:
+        static VisitResult traverse(const Graph& g, int start) { SearchWorkspace ws; return traverseIndexed(g, start, ws); }
+        static VisitResult traverse(const CsrGraph& g, int start) { SearchWorkspace ws; return traverseIndexed(g, start, ws); }
+        static VisitResult traverse(const Graph& g, int start, SearchWorkspace& ws) { return traverseIndexed(g, start, ws); }
+        static VisitResult traverse(const CsrGraph& g, int start, SearchWorkspace& ws) { return traverseIndexed(g, start, ws); }
+
+        // por niveles, frontera en paralelo con cambio arriba-abajo / abajo-arriba; threads <= 0: todos
+        static Levels levels(const Graph& g, int start, int threads = 0) { return levelsIndexed(g, start, threads); }
+        static Levels levels(const CsrGraph& g, int start, int threads = 0) { return levelsIndexed(g, start, threads); }
     };
 
-} // namespace transport
\ No newline at end of file
+} // namespace transport
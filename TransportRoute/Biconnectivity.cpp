@@ -0,0 +1 @@
+#include "Biconnectivity.h"
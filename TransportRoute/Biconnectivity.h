@@ -0,0 +1,134 @@
+#pragma once
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <cstdint>
+#include "Graph.h"
+#include "CsrGraph.h"
+#include "GraphView.h"
+
+namespace transport {
+
+    // Puentes, estaciones de articulacion y componentes biconexas (Tarjan, O(V+E)) sobre las
+    // aristas abiertas. Iterativo (pila explicita) para redes largas. Dos nociones de puente:
+    // 'bridges' es la del multigrafo (dos tramos u-v paralelos nunca son puente, sirve para
+    // quitar un tramo suelto) y 'closureBridges' la de Graph::setClosed, que cierra todos los
+    // tramos u-v juntos: ahi los paralelos cuentan como un solo segmento.
+    class Biconnectivity {
+    public:
+        struct Report {
+            std::vector<std::pair<int, int>> bridges;        // (idMenor, idMayor), ordenados
+            std::vector<std::pair<int, int>> closureBridges; // idem, con los tramos u-v unidos
+            std::vector<int> articulation;                   // ids, ordenados
+            std::vector<std::vector<int>> components;        // ids de cada componente biconexa
+            std::vector<char> isCut;                         // slot -> estacion de articulacion
+            std::vector<int> idOf;                           // slot -> vertexId
+            std::uint64_t version = 0;                       // Graph::version() al calcular
+
+            bool validFor(const Graph& g) const { return version == g.version() && (int)idOf.size() == g.vertexCount(); }
+
+            // quitar un solo tramo u-v deja estaciones sin conexion (con paralelos, nunca)
+            bool isBridge(int u, int v) const { return contains(bridges, u, v); }
+            // setClosed(u, v, true) (todos los tramos u-v) deja estaciones sin conexion
+            bool closureSplits(int u, int v) const { return contains(closureBridges, u, v); }
+            // cerrar la estacion (todas sus aristas) separa la red
+            bool isArticulation(int id) const { return std::binary_search(articulation.begin(), articulation.end(), id); }
+
+        private:
+            static bool contains(const std::vector<std::pair<int, int>>& list, int u, int v) {
+                return std::binary_search(list.begin(), list.end(), std::make_pair(std::min(u, v), std::max(u, v)));
+            }
+        };
+
+        static Report analyze(const Graph& g) { return analyzeIndexed(g, g.version()); }
+        static Report analyze(const CsrGraph& g) { return analyzeIndexed(g, g.sourceVersion); }
+
+    private:
+        struct Frame {
+            int u;
+            int cursor;                  // posicion en la lista de u (ver nextOpenNeighborAt)
+            int parent;
+            bool skippedParent;          // la arista del arbol hacia parent ya se salteo
+        };
+
+        template <typename G>
+        static Report analyzeIndexed(const G& g, std::uint64_t version) {
+            int n = g.vertexCount();
+            Report r;
+            r.version = version;
+            r.idOf.resize(n);
+            for (int i = 0; i < n; ++i) r.idOf[i] = g.idAt(i);
+            r.isCut.assign(n, 0);
+
+            // low: multigrafo (un tramo paralelo al del arbol es retroceso); lowSeg: sin ellos
+            std::vector<int> disc(n, -1), low(n, 0), lowSeg(n, 0);
+            std::vector<Frame> stack;
+            std::vector<std::pair<int, int>> edges;          // aristas de la componente en curso
+            std::vector<int> mark(n, -1);                    // para no repetir vertices en una componente
+            int clock = 0;
+
+            for (int root = 0; root < n; ++root) {
+                if (disc[root] != -1) continue;
+                disc[root] = low[root] = lowSeg[root] = clock++;
+                int rootChildren = 0;
+                stack.push_back(Frame{ root, 0, -1, false });
+                while (!stack.empty()) {
+                    int u = stack.back().u, v;
+                    if (nextOpenNeighborAt(g, u, stack.back().cursor, v)) {
+                        Frame& f = stack.back();
+                        if (v == f.parent) {
+                            // otro tramo hacia el padre: ciclo solo si se cuenta cada tramo
+                            if (f.skippedParent) low[u] = std::min(low[u], disc[v]);
+                            f.skippedParent = true;
+                            continue;
+                        }
+                        if (disc[v] == -1) {
+                            if (f.parent == -1) ++rootChildren;
+                            edges.emplace_back(u, v);
+                            disc[v] = low[v] = lowSeg[v] = clock++;
+                            stack.push_back(Frame{ v, 0, u, false });
+                        }
+                        else if (disc[v] < disc[u]) { // arista de retroceso a un ancestro
+                            edges.emplace_back(u, v);
+                            low[u] = std::min(low[u], disc[v]);
+                            lowSeg[u] = std::min(lowSeg[u], disc[v]);
+                        }
+                        continue;
+                    }
+
+                    // u terminado: propagar low al padre y cerrar componentes
+                    int p = stack.back().parent;
+                    stack.pop_back();
+                    if (p == -1) continue;
+                    low[p] = std::min(low[p], low[u]);
+                    lowSeg[p] = std::min(lowSeg[p], lowSeg[u]);
+                    auto key = std::make_pair(std::min(r.idOf[p], r.idOf[u]), std::max(r.idOf[p], r.idOf[u]));
+                    if (low[u] > disc[p]) r.bridges.push_back(key);
+                    if (lowSeg[u] > disc[p]) r.closureBridges.push_back(key);
+                    if (low[u] >= disc[p]) {
+                        if (stack.back().parent != -1) r.isCut[p] = 1;
+                        int cid = (int)r.components.size();
+                        r.components.emplace_back();
+                        auto& comp = r.components.back();
+                        while (!edges.empty()) {
+                            auto e = edges.back();
+                            edges.pop_back();
+                            for (int x : { e.first, e.second }) {
+                                if (mark[x] != cid) { mark[x] = cid; comp.push_back(r.idOf[x]); }
+                            }
+                            if (e.first == p && e.second == u) break;
+                        }
+                    }
+                }
+                if (rootChildren > 1) r.isCut[root] = 1;
+            }
+
+            for (int i = 0; i < n; ++i) if (r.isCut[i]) r.articulation.push_back(r.idOf[i]);
+            std::sort(r.articulation.begin(), r.articulation.end());
+            std::sort(r.bridges.begin(), r.bridges.end());
+            std::sort(r.closureBridges.begin(), r.closureBridges.end());
+            return r;
+        }
+    };
+
+} // namespace transport
@@ -0,0 +1,159 @@
+#include "CompactAllPairs.h"
+#include <fstream>
+#include <cstdio>
+#include <cmath>
+#include <algorithm>
+
+namespace transport {
+
+    static const char kMagic[8] = { 'T','R','A','P','A','I','R','S' };
+    static const std::uint32_t kFormatVersion = 1;
+
+    static std::uint64_t align64(std::uint64_t x) { return (x + 63) / 64 * 64; }
+
+    CompactAllPairs CompactAllPairs::fromAllPairs(const FloydWarshall::AllPairs& ap, std::uint64_t graphHash, Options opt) {
+        const std::uint64_t n = (std::uint64_t)ap.n;
+        Header h{};
+        std::memcpy(h.magic, kMagic, sizeof kMagic);
+        h.formatVersion = kFormatVersion;
+        h.n = (std::uint32_t)n;
+        h.graphHash = graphHash;
+        h.distFormat = (std::uint32_t)opt.format;
+        h.upperTriangle = opt.upperTriangle ? 1 : 0;
+        h.nextWidth = n < 0xFF ? 1 : (n < 0xFFFF ? 2 : 4); // el maximo queda para -1
+        h.scale = 1.0;
+
+        std::uint64_t distCount = opt.upperTriangle ? n * (n + 1) / 2 : n * n;
+        std::uint64_t distBytes = distCount * (opt.format == DistFormat::Float32 ? 4 : 2);
+        h.idOffset = align64(sizeof(Header));
+        h.distOffset = align64(h.idOffset + n * 4);
+        h.nextOffset = align64(h.distOffset + distBytes);
+        h.totalSize = align64(h.nextOffset + n * n * h.nextWidth);
+
+        if (opt.format == DistFormat::Int16) {
+            double maxFinite = 0.0;
+            for (double d : ap.dist) if (!std::isinf(d)) maxFinite = std::max(maxFinite, d);
+            h.scale = maxFinite > 0.0 ? maxFinite / 65534.0 : 1.0;
+        }
+
+        CompactAllPairs c;
+        c.owned_.assign((size_t)h.totalSize, 0);
+        std::uint8_t* b = c.owned_.data();
+        std::memcpy(b, &h, sizeof h);
+
+        std::int32_t* ids = reinterpret_cast<std::int32_t*>(b + h.idOffset);
+        for (std::uint64_t i = 0; i < n; ++i) ids[i] = ap.idOf[i];
+
+        auto putDist = [&](size_t k, double d) {
+            if (opt.format == DistFormat::Float32) { reinterpret_cast<float*>(b + h.distOffset)[k] = (float)d; return; }
+            std::uint16_t q = std::isinf(d) ? 0xFFFF : (std::uint16_t)std::min(65534.0, std::round(d / h.scale));
+            reinterpret_cast<std::uint16_t*>(b + h.distOffset)[k] = q;
+        };
+        size_t k = 0;
+        for (std::uint64_t i = 0; i < n; ++i) {
+            for (std::uint64_t j = opt.upperTriangle ? i : 0; j < n; ++j) putDist(k++, ap.dist[i * n + j]);
+        }
+
+        std::uint8_t* nx = b + h.nextOffset;
+        for (size_t e = 0; e < (size_t)(n * n); ++e) {
+            int v = ap.next[e];
+            switch (h.nextWidth) {
+            case 1: nx[e] = v < 0 ? 0xFF : (std::uint8_t)v; break;
+            case 2: reinterpret_cast<std::uint16_t*>(nx)[e] = v < 0 ? 0xFFFF : (std::uint16_t)v; break;
+            default: reinterpret_cast<std::int32_t*>(nx)[e] = v; break;
+            }
+        }
+        c.indexIds();
+        return c;
+    }
+
+    std::optional<CompactAllPairs> CompactAllPairs::open(const std::string& path) {
+        auto file = std::make_shared<MappedFile>();
+        if (!file->open(path) || file->size() < sizeof(Header)) return std::nullopt;
+        const Header& h = *reinterpret_cast<const Header*>(file->data());
+        if (std::memcmp(h.magic, kMagic, sizeof kMagic) != 0 || h.formatVersion != kFormatVersion) return std::nullopt;
+        if (h.totalSize != file->size()) return std::nullopt; // truncado
+        CompactAllPairs c;
+        c.mapped_ = std::move(file);
+        c.indexIds();
+        return c;
+    }
+
+    bool CompactAllPairs::save(const std::string& path) const {
+        // escribir aparte y renombrar: un lector nunca ve un archivo a medias
+        std::string tmp = path + ".tmp";
+        {
+            std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+            if (!out) return false;
+            out.write(reinterpret_cast<const char*>(base()), (std::streamsize)bytes());
+            if (!out) return false;
+        }
+        std::remove(path.c_str());
+        return std::rename(tmp.c_str(), path.c_str()) == 0;
+    }
+
+    std::uint64_t CompactAllPairs::graphHash(const Graph& g) {
+        std::uint64_t h = 1469598103934665603ull;
+        auto mix = [&h](const void* p, size_t len) {
+            const unsigned char* c = static_cast<const unsigned char*>(p);
+            for (size_t i = 0; i < len; ++i) { h ^= c[i]; h *= 1099511628211ull; }
+        };
+        int n = g.vertexCount();
+        mix(&n, sizeof n);
+        for (int s = 0; s < n; ++s) {
+            int id = g.idAt(s);
+            mix(&id, sizeof id);
+            for (const auto& e : g.neighborsAt(s)) {
+                unsigned char closed = e.closed ? 1 : 0;
+                mix(&e.to, sizeof e.to);
+                mix(&e.w, sizeof e.w);
+                mix(&closed, 1);
+            }
+        }
+        return h;
+    }
+
+    template <typename G>
+    FloydWarshall::AllPairs CompactAllPairs::expandIndexed(const G& g) const {
+        const double INF = std::numeric_limits<double>::infinity();
+        int n = size();
+        FloydWarshall::AllPairs ap;
+        ap.n = n;
+        ap.idOf.assign(idOf(), idOf() + n);
+        ap.idxOf = idxOf_;
+        ap.next.resize((size_t)n * n);
+        for (int i = 0; i < n; ++i) for (int j = 0; j < n; ++j) ap.next[(size_t)i * n + j] = nextAt(i, j);
+
+        ap.dist.assign((size_t)n * n, INF);
+        std::vector<int> chain;
+        for (int t = 0; t < n; ++t) {
+            ap.dist[(size_t)t * n + t] = 0.0;
+            for (int i = 0; i < n; ++i) {
+                // subir por next hasta un vertice ya resuelto y sumar de vuelta
+                int u = i;
+                while (ap.next[(size_t)u * n + t] != -1 && std::isinf(ap.dist[(size_t)u * n + t])) {
+                    chain.push_back(u);
+                    u = ap.next[(size_t)u * n + t];
+                }
+                for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+                    int v = ap.next[(size_t)*it * n + t];
+                    ap.dist[(size_t)*it * n + t] = hopWeight(g, *it, v) + ap.dist[(size_t)v * n + t];
+                }
+                chain.clear();
+            }
+        }
+        return ap;
+    }
+
+    FloydWarshall::AllPairs CompactAllPairs::expand(const Graph& g) const { return expandIndexed(g); }
+    FloydWarshall::AllPairs CompactAllPairs::expand(const CsrGraph& g) const { return expandIndexed(g); }
+
+    void CompactAllPairs::indexIds() {
+        int n = size();
+        const std::int32_t* ids = idOf();
+        idxOf_.clear();
+        idxOf_.reserve(n);
+        for (int i = 0; i < n; ++i) idxOf_[ids[i]] = i;
+    }
+
+} // namespace transport
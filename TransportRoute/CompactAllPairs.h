@@ -0,0 +1,145 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include "Result.h"
+#include "Graph.h"
+#include "CsrGraph.h"
+#include "FloydWarshall.h"
+#include "GraphView.h"
+#include "MappedFile.h"
+
+namespace transport {
+
+    // Todos-los-pares compacto: distancias en float o uint16 cuantizado (opcionalmente solo el
+    // triangulo superior, el grafo es no dirigido) y 'next' con el ancho minimo para N.
+    // La imagen en memoria es la misma que en disco, asi que open() mapea el archivo sin copiarlo.
+    // Las distancias guardadas son aproximadas; path(.., g) y expand() devuelven costos exactos
+    // sumando los pesos del grafo a lo largo de 'next' (que si es exacto).
+    class CompactAllPairs {
+    public:
+        enum class DistFormat : std::uint32_t { Float32 = 0, Int16 = 1 };
+        struct Options {
+            DistFormat format = DistFormat::Float32;
+            bool upperTriangle = false;
+        };
+
+        static CompactAllPairs fromAllPairs(const FloydWarshall::AllPairs& ap, std::uint64_t graphHash, Options opt);
+        static CompactAllPairs fromAllPairs(const FloydWarshall::AllPairs& ap, std::uint64_t graphHash) { return fromAllPairs(ap, graphHash, Options{}); }
+        // null si el archivo no existe o no es valido
+        static std::optional<CompactAllPairs> open(const std::string& path);
+        bool save(const std::string& path) const;
+
+        // FNV-1a sobre ids, aristas, pesos y cierres (en orden de slot)
+        static std::uint64_t graphHash(const Graph& g);
+
+        int size() const { return (int)header().n; }
+        std::uint64_t hash() const { return header().graphHash; }
+        size_t bytes() const { return (size_t)header().totalSize; }
+        bool isMapped() const { return mapped_ != nullptr; }
+
+        double distance(int srcId, int dstId) const {
+            auto itS = idxOf_.find(srcId), itD = idxOf_.find(dstId);
+            if (itS == idxOf_.end() || itD == idxOf_.end()) return std::numeric_limits<double>::infinity();
+            return distAt(itS->second, itD->second);
+        }
+
+        // misma interfaz que AllPairs::path; el costo viene de la distancia compacta
+        PathResult path(int srcId, int dstId) const {
+            PathResult res; res.algo = "FloydWarshall(compact)";
+            auto itS = idxOf_.find(srcId), itD = idxOf_.find(dstId);
+            if (itS == idxOf_.end() || itD == idxOf_.end()) return res;
+            int s = itS->second, t = itD->second;
+            if (nextAt(s, t) == -1) return res;
+            res.reachable = true;
+            res.cost = distAt(s, t);
+            const std::int32_t* ids = idOf();
+            int u = s;
+            res.path.push_back(ids[u]);
+            while (u != t) {
+                u = nextAt(u, t);
+                res.path.push_back(ids[u]);
+            }
+            return res;
+        }
+
+        // camino con costo exacto: suma los tramos con los pesos de g (el grafo de hash()). O(largo)
+        PathResult path(int srcId, int dstId, const Graph& g) const {
+            PathResult res = path(srcId, dstId);
+            if (!res.reachable) return res;
+            res.cost = 0.0;
+            for (size_t i = 0; i + 1 < res.path.size(); ++i) res.cost += hopWeight(g, g.indexOf(res.path[i]), g.indexOf(res.path[i + 1]));
+            return res;
+        }
+
+        // AllPairs con distancias exactas: next se copia y cada dist se vuelve a sumar con los
+        // pesos del grafo (que deben coincidir con hash(); la foto CSR sirve igual). O(N^2).
+        FloydWarshall::AllPairs expand(const Graph& g) const;
+        FloydWarshall::AllPairs expand(const CsrGraph& g) const;
+
+        double distAt(int s, int t) const {
+            const Header& h = header();
+            if (h.upperTriangle && s > t) std::swap(s, t);
+            size_t k = h.upperTriangle ? triIndex(s, t, h.n) : (size_t)s * h.n + t;
+            const std::uint8_t* p = base() + h.distOffset;
+            if ((DistFormat)h.distFormat == DistFormat::Float32) return reinterpret_cast<const float*>(p)[k];
+            std::uint16_t q = reinterpret_cast<const std::uint16_t*>(p)[k];
+            return q == 0xFFFF ? std::numeric_limits<double>::infinity() : q * h.scale;
+        }
+
+        int nextAt(int s, int t) const {
+            const Header& h = header();
+            size_t k = (size_t)s * h.n + t;
+            const std::uint8_t* p = base() + h.nextOffset;
+            switch (h.nextWidth) {
+            case 1: { std::uint8_t v = p[k]; return v == 0xFF ? -1 : v; }
+            case 2: { std::uint16_t v = reinterpret_cast<const std::uint16_t*>(p)[k]; return v == 0xFFFF ? -1 : v; }
+            default: return reinterpret_cast<const std::int32_t*>(p)[k];
+            }
+        }
+
+    private:
+        struct Header {
+            char magic[8];
+            std::uint32_t formatVersion;
+            std::uint32_t n;
+            std::uint64_t graphHash;
+            std::uint32_t distFormat;
+            std::uint32_t upperTriangle;
+            std::uint32_t nextWidth;      // bytes por entrada: 1, 2 o 4
+            std::uint32_t reserved;
+            double scale;                 // Int16: distancia = q * scale (0xFFFF = infinito)
+            std::uint64_t idOffset;       // secciones alineadas a 64 bytes
+            std::uint64_t distOffset;
+            std::uint64_t nextOffset;
+            std::uint64_t totalSize;
+        };
+
+        std::vector<std::uint8_t> owned_;           // imagen propia (fromAllPairs)
+        std::shared_ptr<MappedFile> mapped_;        // o archivo mapeado (open)
+        std::unordered_map<int, int> idxOf_;
+
+        const std::uint8_t* base() const { return mapped_ ? mapped_->data() : owned_.data(); }
+        const Header& header() const { return *reinterpret_cast<const Header*>(base()); }
+        const std::int32_t* idOf() const { return reinterpret_cast<const std::int32_t*>(base() + header().idOffset); }
+        void indexIds();
+        template <typename G>
+        FloydWarshall::AllPairs expandIndexed(const G& g) const;
+
+        // el tramo i -> v mas barato (el que uso el calculo)
+        template <typename G>
+        static double hopWeight(const G& g, int i, int v) {
+            double best = std::numeric_limits<double>::infinity();
+            forEachOpenNeighborAt(g, i, [&](int x, double w) { if (x == v && w < best) best = w; });
+            return best;
+        }
+
+        static size_t triIndex(size_t i, size_t j, size_t n) { return i * n - i * (i - 1) / 2 + (j - i); } // i <= j
+    };
+
+} // namespace transport
@@ -0,0 +1 @@
+#include "Connectivity.h"
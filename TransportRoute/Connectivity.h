@@ -0,0 +1,71 @@
+#pragma once
+#include <vector>
+#include <unordered_set>
+#include <utility>
+#include <cstdint>
+
+namespace transport {
+
+    // Conectividad dinamica por slot para responder "hay camino u-v" sin buscar.
+    // Inserciones: union-find (union por tamano, compresion por mitades) y la arista que une dos
+    // componentes queda en el bosque generador. Borrar/cerrar una arista fuera del bosque no cambia
+    // nada (el bosque sigue generando); borrar una del bosque marca el indice sucio y se rearma en
+    // O(V+E) en la siguiente consulta, asi un lote de cierres paga una sola reconstruccion.
+    // connected() sin reconstruccion pendiente es O(log N) y no escribe (find sin compresion).
+    class DynamicConnectivity {
+        std::vector<int> parent_;
+        std::vector<int> size_;
+        std::unordered_set<std::uint64_t> forest_;   // pares (min,max) de slots del bosque
+        bool dirty_ = false;
+
+        static std::uint64_t key(int a, int b) {
+            if (a > b) std::swap(a, b);
+            return (std::uint64_t(std::uint32_t(a)) << 32) | std::uint32_t(b);
+        }
+        int find(int x) {
+            while (parent_[x] != x) { parent_[x] = parent_[parent_[x]]; x = parent_[x]; }
+            return x;
+        }
+        int root(int x) const {
+            while (parent_[x] != x) x = parent_[x];
+            return x;
+        }
+
+    public:
+        void clear() { parent_.clear(); size_.clear(); forest_.clear(); dirty_ = false; }
+        void addVertex() { parent_.push_back((int)parent_.size()); size_.push_back(1); }
+
+        // arista abierta nueva (o reabierta) entre slots a y b
+        void insert(int a, int b) {
+            if (dirty_) return; // la reconstruccion la va a incluir
+            int ra = find(a), rb = find(b);
+            if (ra == rb) return;
+            if (size_[ra] < size_[rb]) std::swap(ra, rb);
+            parent_[rb] = ra;
+            size_[ra] += size_[rb];
+            forest_.insert(key(a, b));
+        }
+
+        // ya no queda ninguna arista abierta entre a y b
+        void erase(int a, int b) {
+            if (!dirty_ && forest_.count(key(a, b))) dirty_ = true;
+        }
+
+        bool dirty() const { return dirty_; }
+
+        // forEachOpenEdge(add) debe llamar add(a, b) una vez por arista abierta
+        template <typename ForEachOpenEdge>
+        void rebuild(int n, ForEachOpenEdge forEachOpenEdge) {
+            parent_.resize(n);
+            size_.assign(n, 1);
+            for (int i = 0; i < n; ++i) parent_[i] = i;
+            forest_.clear();
+            dirty_ = false;
+            forEachOpenEdge([this](int a, int b) { insert(a, b); });
+        }
+
+        bool connected(int a, int b) const { return root(a) == root(b); }
+        int componentSize(int a) const { return size_[root(a)]; }
+    };
+
+} // namespace transport
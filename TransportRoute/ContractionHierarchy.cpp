@@ -0,0 +1 @@
+#include "ContractionHierarchy.h"
@@ -0,0 +1,261 @@
+#pragma once
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <algorithm>
+#include <utility>
+#include "Result.h"
+#include "GraphView.h"
+#include "SearchWorkspace.h"
+#include "Dijkstra.h"
+
+namespace transport {
+
+    // Contraction Hierarchies: se contraen los vertices en orden de importancia (diferencia de
+    // aristas), agregando atajos cuando la busqueda de testigos no encuentra un camino alternativo.
+    // La consulta es un Dijkstra bidireccional que solo sube de rango y el camino se desempaqueta
+    // a ids originales. Se preprocesa sobre las aristas abiertas en ese momento.
+    class CH {
+    public:
+        struct Hierarchy {
+            int n = 0;
+            std::vector<int> rank;          // slot -> orden de contraccion
+            std::vector<int> upOffsets;     // CSR: aristas hacia vecinos de mayor rango
+            std::vector<int> upTargets;
+            std::vector<double> upWeights;
+            std::vector<int> upMiddle;      // -1 = arista original; si no, vertice contraido del atajo
+            int shortcuts = 0;
+            std::uint64_t version = 0;          // Graph::version() al preprocesar
+            std::uint64_t decreaseVersion = 0;  // Graph::decreaseVersion() al preprocesar
+
+            // cierres y subidas de peso no la invalidan (se verifica el camino en la consulta);
+            // aristas nuevas/reabiertas o pesos menores si
+            bool validFor(const Graph& g) const { return n == g.vertexCount() && decreaseVersion == g.decreaseVersion(); }
+
+            // arista entre a y b (guardada en el de menor rango); -1 si no existe
+            int findEdge(int a, int b) const {
+                int lo = rank[a] < rank[b] ? a : b, hi = lo == a ? b : a;
+                for (int k = upOffsets[lo]; k < upOffsets[lo + 1]; ++k) if (upTargets[k] == hi) return k;
+                return -1;
+            }
+        };
+
+        // witnessSettleLimit acota cada busqueda de testigos (atajos de mas no afectan la correctitud)
+        static Hierarchy preprocess(const Graph& g, int witnessSettleLimit = 500) {
+            Hierarchy h;
+            int n = g.vertexCount();
+            h.n = n;
+            h.version = g.version();
+            h.decreaseVersion = g.decreaseVersion();
+
+            Builder b(n, witnessSettleLimit);
+            for (int u = 0; u < n; ++u) {
+                for (const auto& e : g.neighborsAt(u)) {
+                    if (!e.closed && u < e.slot) b.addOrImprove(u, e.slot, e.w, -1);
+                }
+            }
+
+            // prioridades iniciales (contraccion simulada)
+            IndexedDaryHeap<4> pq;
+            pq.reserve(n);
+            for (int v = 0; v < n; ++v) pq.pushOrDecrease(v, b.priority(v));
+
+            h.rank.assign(n, 0);
+            std::vector<std::vector<Builder::CEdge>> up(n);
+            int order = 0;
+            while (!pq.empty()) {
+                int v = pq.pop().second;
+                // actualizacion perezosa: si ya no es el minimo, reinsertar
+                double p = b.priority(v);
+                if (!pq.empty() && p > pq.top().first) { pq.pushOrDecrease(v, p); continue; }
+
+                h.rank[v] = order++;
+                up[v] = b.adj[v];
+                h.shortcuts += b.contract(v, true);
+                for (const auto& e : up[v]) {
+                    b.deletedNeighbors[e.to]++;
+                    pq.update(e.to, b.priority(e.to));
+                }
+            }
+
+            h.upOffsets.assign(n + 1, 0);
+            for (int v = 0; v < n; ++v) {
+                for (const auto& e : up[v]) {
+                    h.upTargets.push_back(e.to);
+                    h.upWeights.push_back(e.w);
+                    h.upMiddle.push_back(e.mid);
+                }
+                h.upOffsets[v + 1] = (int)h.upTargets.size();
+            }
+            return h;
+        }
+
+        static PathResult shortestPath(const Graph& g, const Hierarchy& h, int src, int dst) {
+            SearchWorkspace fw, bw; return query(g, h, src, dst, fw, bw);
+        }
+        static PathResult shortestPath(const Graph& g, const Hierarchy& h, int src, int dst, SearchWorkspace& fw, SearchWorkspace& bw) {
+            return query(g, h, src, dst, fw, bw);
+        }
+
+    private:
+        struct Builder {
+            struct CEdge { int to; double w; int mid; };
+            std::vector<std::vector<CEdge>> adj;   // solo vecinos no contraidos
+            std::vector<char> contracted;
+            std::vector<int> deletedNeighbors;
+            SearchWorkspace ws;
+            int settleLimit;
+
+            Builder(int n, int limit) : adj(n), contracted(n, 0), deletedNeighbors(n, 0), settleLimit(limit) {}
+
+            void addOrImprove(int a, int b, double w, int mid) {
+                for (auto& e : adj[a]) {
+                    if (e.to != b) continue;
+                    if (w < e.w) {
+                        e.w = w; e.mid = mid;
+                        for (auto& f : adj[b]) if (f.to == a) { f.w = w; f.mid = mid; }
+                    }
+                    return;
+                }
+                adj[a].push_back({ b, w, mid });
+                adj[b].push_back({ a, w, mid });
+            }
+
+            // Dijkstra acotado desde u sin pasar por 'skip' ni por contraidos
+            void witness(int u, int skip, double maxDist) {
+                ws.reset((int)adj.size());
+                ws.set(u, 0.0, -1);
+                ws.heap.pushOrDecrease(u, 0.0);
+                int settledCount = 0;
+                while (!ws.heap.empty()) {
+                    auto [du, x] = ws.heap.pop();
+                    ws.settle(x);
+                    if (du > maxDist || ++settledCount > settleLimit) break;
+                    for (const auto& e : adj[x]) {
+                        if (e.to == skip || contracted[e.to]) continue;
+                        double nd = du + e.w;
+                        if (!ws.settled(e.to) && nd < ws.dist(e.to)) {
+                            ws.set(e.to, nd, x);
+                            ws.heap.pushOrDecrease(e.to, nd);
+                        }
+                    }
+                }
+            }
+
+            // atajos necesarios al contraer v (los agrega si apply)
+            int contract(int v, bool apply) {
+                const auto nb = adj[v]; // copia: addOrImprove modifica listas
+                int added = 0;
+                for (size_t i = 0; i + 1 < nb.size(); ++i) {
+                    double maxW = 0.0;
+                    for (size_t j = i + 1; j < nb.size(); ++j) maxW = std::max(maxW, nb[i].w + nb[j].w);
+                    witness(nb[i].to, v, maxW);
+                    for (size_t j = i + 1; j < nb.size(); ++j) {
+                        double via = nb[i].w + nb[j].w;
+                        if (ws.dist(nb[j].to) <= via) continue; // hay testigo
+                        ++added;
+                        if (apply) addOrImprove(nb[i].to, nb[j].to, via, v);
+                    }
+                }
+                if (apply) {
+                    contracted[v] = 1;
+                    for (const auto& e : nb) {
+                        auto& l = adj[e.to];
+                        l.erase(std::remove_if(l.begin(), l.end(), [v](const CEdge& x) { return x.to == v; }), l.end());
+                    }
+                }
+                return added;
+            }
+
+            // diferencia de aristas + vecinos ya contraidos
+            double priority(int v) {
+                return (double)contract(v, false) - (double)adj[v].size() + (double)deletedNeighbors[v];
+            }
+        };
+
+        static PathResult query(const Graph& g, const Hierarchy& h, int srcId, int dstId, SearchWorkspace& fw, SearchWorkspace& bw) {
+            if (!h.validFor(g)) {
+                auto r = Dijkstra::bidirectional(g, srcId, dstId, fw, bw);
+                r.algo = "CH->BidirectionalDijkstra"; // jerarquia desactualizada
+                return r;
+            }
+            PathResult res; res.algo = "CH";
+            int src = g.indexOf(srcId), dst = g.indexOf(dstId);
+            if (src < 0 || dst < 0) return res;
+
+            const double INF = std::numeric_limits<double>::infinity();
+            fw.reset(h.n); bw.reset(h.n);
+            fw.set(src, 0.0, -1); fw.heap.pushOrDecrease(src, 0.0);
+            bw.set(dst, 0.0, -1); bw.heap.pushOrDecrease(dst, 0.0);
+            double mu = src == dst ? 0.0 : INF;
+            int meet = src == dst ? src : -1;
+
+            auto step = [&](SearchWorkspace& self, const SearchWorkspace& other) {
+                auto [du, u] = self.heap.pop();
+                self.settle(u);
+                for (int k = h.upOffsets[u]; k < h.upOffsets[u + 1]; ++k) {
+                    int v = h.upTargets[k];
+                    double nd = du + h.upWeights[k];
+                    if (self.settled(v) || !(nd < self.dist(v))) continue;
+                    self.set(v, nd, u);
+                    self.heap.pushOrDecrease(v, nd);
+                    if (other.reached(v) && nd + other.dist(v) < mu) { mu = nd + other.dist(v); meet = v; }
+                }
+                };
+
+            // cada lado para cuando su minimo ya no puede mejorar mu
+            for (;;) {
+                bool f = !fw.heap.empty() && fw.heap.top().first < mu;
+                bool b = !bw.heap.empty() && bw.heap.top().first < mu;
+                if (!f && !b) break;
+                if (f) step(fw, bw);
+                if (b) step(bw, fw);
+            }
+
+            if (meet < 0) return res; // unreachable (cierres/subidas no pueden conectar)
+
+            // secuencia en la jerarquia: src .. meet .. dst
+            std::vector<int> chPath;
+            for (int cur = meet; cur != -1; cur = fw.parent(cur)) chPath.push_back(cur);
+            std::reverse(chPath.begin(), chPath.end());
+            for (int cur = bw.parent(meet); cur != -1; cur = bw.parent(cur)) chPath.push_back(cur);
+
+            // desempaquetar atajos
+            std::vector<int> path{ chPath.front() };
+            std::vector<std::pair<int, int>> stack;
+            for (size_t i = 1; i < chPath.size(); ++i) {
+                stack.push_back({ chPath[i - 1], chPath[i] });
+                while (!stack.empty()) {
+                    auto [a, b] = stack.back(); stack.pop_back();
+                    int m = h.upMiddle[h.findEdge(a, b)];
+                    if (m < 0) { path.push_back(b); continue; }
+                    stack.push_back({ m, b });
+                    stack.push_back({ a, m });
+                }
+            }
+
+            // si el grafo cambio (solo cierres/subidas), el camino vale si sigue abierto y con el mismo costo
+            if (g.version() != h.version) {
+                double cost = 0.0;
+                for (size_t i = 1; i < path.size() && !std::isinf(cost); ++i) {
+                    double best = INF;
+                    for (const auto& e : g.neighborsAt(path[i - 1])) if (!e.closed && e.slot == path[i]) best = std::min(best, e.w);
+                    cost += best;
+                }
+                if (std::isinf(cost) || std::fabs(cost - mu) > 1e-9 * std::max(1.0, std::fabs(mu))) {
+                    auto r = Dijkstra::bidirectional(g, srcId, dstId, fw, bw);
+                    r.algo = "CH->BidirectionalDijkstra"; // el camino de la jerarquia ya no es valido
+                    return r;
+                }
+            }
+
+            res.reachable = true;
+            res.cost = mu;
+            res.path.reserve(path.size());
+            for (int v : path) res.path.push_back(g.idAt(v));
+            return res;
+        }
+    };
+
+} // namespace transport
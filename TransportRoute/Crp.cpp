@@ -0,0 +1 @@
+#include "Crp.h"
@@ -0,0 +1,613 @@
+#pragma once
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <algorithm>
+#include <utility>
+#include "Result.h"
+#include "Graph.h"
+#include "SearchWorkspace.h"
+#include "Parallel.h"
+#include "Dijkstra.h"
+
+namespace transport {
+
+    // Customizable Route Planning: particion multinivel independiente de los pesos (se calcula
+    // una vez) + metrica por celda (clique entre vertices frontera). Cambiar pesos o cerrar
+    // aristas solo obliga a recalcular los cliques de las celdas que contienen esas aristas,
+    // en paralelo por nivel. La consulta es un Dijkstra bidireccional sobre el overlay.
+    class CRP {
+    public:
+        struct Partition {
+            int n = 0;
+            // cellOf[L][slot]: celda del vertice en el nivel L (0 = celdas mas chicas); anidadas
+            std::vector<std::vector<int>> cellOf;
+            std::vector<int> cellCount;       // por nivel
+
+            int levels() const { return (int)cellOf.size(); }
+            bool validFor(const Graph& g) const { return n == g.vertexCount(); }
+        };
+
+        struct Metric {
+            // por nivel: frontera de cada celda (vertices con alguna arista que sale de ella)
+            std::vector<std::vector<int>> boundaryOffsets;   // [L][celda] -> inicio en boundary[L]
+            std::vector<std::vector<int>> boundary;          // [L] slots
+            std::vector<std::vector<int>> boundaryIdx;       // [L][slot] -> indice local en su celda o -1
+            // clique por celda: matriz B x B fila-mayor
+            std::vector<std::vector<size_t>> cliqueOffsets;  // [L][celda]
+            std::vector<std::vector<double>> clique;         // [L]
+            // vertices que recorre la busqueda de cada celda: en el nivel 0 todos los de la celda,
+            // en el nivel L las fronteras del nivel L-1 que caen en ella
+            std::vector<std::vector<int>> overlayOffsets;    // [L][celda] -> inicio en overlay[L]
+            std::vector<std::vector<int>> overlay;           // [L] slots
+            std::vector<std::vector<int>> overlayIdx;        // [L][slot] -> indice local o -1
+            // arbol de cada fila del clique (padre como indice local del overlay): desempaqueta un
+            // tramo sin volver a buscar. Vacio en un nivel con celdas de mas de 65535 vertices de
+            // overlay (ahi se desempaqueta buscando)
+            static constexpr std::uint16_t NoParent = 0xFFFF;
+            std::vector<std::vector<size_t>> treeOffsets;    // [L][celda]
+            std::vector<std::vector<std::uint16_t>> tree;    // [L] B x V fila-mayor
+            // foto de las aristas al customizar, para detectar que cambio
+            std::vector<int> snapOffsets;
+            std::vector<Graph::AdjEdge> snapEdges;
+            std::uint64_t version = 0;       // Graph::version() de la ultima customizacion
+            bool ready = false;
+
+            bool validFor(const Graph& g) const { return ready && version == g.version(); }
+        };
+
+        // biseccion recursiva de arriba hacia abajo: cada region se corta por un corte minimo de
+        // aristas (flujo maximo, capacidades unitarias) entre los extremos de un orden BFS; la celda
+        // del nivel L es la region mas grande de a lo sumo cellSizes[L] vertices. Usa todas las
+        // aristas (tambien cerradas): no depende de la metrica.
+        static Partition partition(const Graph& g, const std::vector<int>& cellSizes = { 16, 64, 256, 1024, 4096 }) {
+            Partition p;
+            int n = g.vertexCount();
+            p.n = n;
+            int L = (int)cellSizes.size();
+            if (n == 0 || L == 0) return p;
+
+            Bisector cut(g);
+            std::vector<std::vector<int>> cellOf(L, std::vector<int>(n, -1));
+            std::vector<int> count(L, 0);
+            std::vector<int> all(n);
+            for (int v = 0; v < n; ++v) all[v] = v;
+            split(cut, all, cellSizes, std::vector<int>(L, -1), cellOf, count);
+
+            int units = n;                      // nivel -1: cada vertice
+            for (int l = 0; l < L; ++l) {
+                if (count[l] <= 1) break;       // una sola celda no aporta
+                if (count[l] == units) continue; // mismo corte que el nivel anterior
+                p.cellOf.push_back(std::move(cellOf[l]));
+                p.cellCount.push_back(count[l]);
+                units = count[l];
+            }
+            return p;
+        }
+
+        // recalcula los cliques afectados por cambios desde la ultima llamada (todos la primera vez
+        // o si cambio la topologia). Devuelve la cantidad de celdas recalculadas.
+        static int customize(const Graph& g, const Partition& p, Metric& m, int threads = 0) {
+            if (m.validFor(g)) return 0;
+            int L = p.levels();
+            bool full = !m.ready || !sameTopology(g, m);
+            if (full) buildBoundaries(g, p, m);
+
+            // tramos que cambiaron en la busqueda de cada nivel: una arista original en el primer
+            // nivel que la contiene; mas arriba, las entradas del clique inferior que cambiaron
+            std::vector<std::vector<Change>> changes(L);
+            if (!full) {
+                for (int u = 0; u < g.vertexCount(); ++u) {
+                    const auto& now = g.neighborsAt(u);
+                    const Graph::AdjEdge* old = m.snapEdges.data() + m.snapOffsets[u];
+                    for (size_t k = 0; k < now.size(); ++k) {
+                        bool open = !now[k].closed, wasOpen = !old[k].closed;
+                        if (open == wasOpen && (!open || now[k].w == old[k].w)) continue; // la busqueda no lo nota
+                        int v = now[k].slot, l = 0;
+                        while (l < L && p.cellOf[l][u] != p.cellOf[l][v]) ++l;
+                        if (l == L) continue; // entre celdas del nivel mas alto: la consulta la usa directo
+                        changes[l].push_back({ u, v, !open || (wasOpen && now[k].w > old[k].w) });
+                    }
+                }
+            }
+
+            int recomputed = 0;
+            std::vector<SearchWorkspace> ws(workerCount(threads));
+            for (int l = 0; l < L; ++l) { // los niveles altos usan los cliques de los bajos
+                // una tarea por fila del clique: una celda grande no deja hilos ociosos
+                std::vector<std::pair<int, int>> rows;
+                if (full) {
+                    recomputed += p.cellCount[l];
+                    for (int c = 0; c < p.cellCount[l]; ++c) {
+                        int B = m.boundaryOffsets[l][c + 1] - m.boundaryOffsets[l][c];
+                        for (int i = 0; i < B; ++i) rows.push_back({ c, i });
+                    }
+                }
+                else rows = dirtyRows(p, m, l, changes[l], recomputed);
+                std::vector<std::vector<Change>> diff(full ? 0 : rows.size());
+                parallelFor(0, (int)rows.size(), [&](int k, int w) {
+                    customizeRow(g, p, m, l, rows[k].first, rows[k].second, ws[w], full ? nullptr : &diff[k]);
+                    }, (int)ws.size());
+                if (l + 1 < L) for (const auto& d : diff) changes[l + 1].insert(changes[l + 1].end(), d.begin(), d.end());
+            }
+
+            takeSnapshot(g, m);
+            m.version = g.version();
+            m.ready = true;
+            return recomputed;
+        }
+
+        static PathResult shortestPath(const Graph& g, const Partition& p, const Metric& m, int src, int dst) {
+            SearchWorkspace fw, bw; return query(g, p, m, src, dst, fw, bw);
+        }
+        static PathResult shortestPath(const Graph& g, const Partition& p, const Metric& m, int src, int dst, SearchWorkspace& fw, SearchWorkspace& bw) {
+            return query(g, p, m, src, dst, fw, bw);
+        }
+
+    private:
+        // corte de una region en dos: orden BFS desde un vertice periferico, los primeros
+        // Terminal del orden son fuente y los ultimos sumidero; flujo maximo (Dinic, capacidad 1 por
+        // arista) y el lado fuente es lo alcanzable en el residual. Se prueban dos ordenes
+        // (desde a, lejano, y desde c, lejano de a y de b) y queda el corte con menos aristas.
+        class Bisector {
+            const Graph& g_;
+            std::vector<int> local_;            // slot -> indice en la region o -1
+            std::vector<int> off_, to_, edge_;  // region como CSR; edge_ = arista no dirigida
+            std::vector<int> eu_, ev_;          // extremos de cada arista (flujo positivo = u -> v)
+            std::vector<signed char> flow_;
+            std::vector<int> level_, dist_, it_, queue_, order_;
+            std::vector<std::pair<int, int>> stack_;
+
+            static constexpr double Terminal = 0.25;
+
+            int residual(int x, int k) const { return 1 - (eu_[edge_[k]] == x ? flow_[edge_[k]] : -flow_[edge_[k]]); }
+            void push(int x, int k) { flow_[edge_[k]] += eu_[edge_[k]] == x ? 1 : -1; }
+
+            // orden BFS desde root (las otras componentes despues); deja distancias en dist_
+            void bfsOrder(int root, int m) {
+                dist_.assign(m, -1);
+                order_.clear();
+                for (int r = root, next = 0; (int)order_.size() < m; r = next) {
+                    while (dist_[r] >= 0) r = ++next;
+                    dist_[r] = 0;
+                    size_t head = order_.size();
+                    order_.push_back(r);
+                    for (; head < order_.size(); ++head) {
+                        int x = order_[head];
+                        for (int k = off_[x]; k < off_[x + 1]; ++k) {
+                            if (dist_[to_[k]] < 0) { dist_[to_[k]] = dist_[x] + 1; order_.push_back(to_[k]); }
+                        }
+                    }
+                }
+            }
+
+            // niveles desde todas las fuentes por el residual; true si llega a algun sumidero
+            bool levels(const std::vector<char>& side, int m) {
+                level_.assign(m, -1);
+                queue_.clear();
+                for (int x = 0; x < m; ++x) if (side[x] == 1) { level_[x] = 0; queue_.push_back(x); }
+                bool reached = false;
+                for (size_t head = 0; head < queue_.size(); ++head) {
+                    int x = queue_[head];
+                    if (side[x] == 2) { reached = true; continue; }
+                    for (int k = off_[x]; k < off_[x + 1]; ++k) {
+                        int y = to_[k];
+                        if (level_[y] < 0 && residual(x, k) > 0) { level_[y] = level_[x] + 1; queue_.push_back(y); }
+                    }
+                }
+                return reached;
+            }
+
+            // corte minimo entre side==1 y side==2; devuelve la cantidad de aristas del corte y
+            // deja en 'source' el lado fuente
+            int minCut(const std::vector<char>& side, int m, std::vector<char>& source) {
+                std::fill(flow_.begin(), flow_.end(), 0);
+                int total = 0;
+                while (levels(side, m)) {
+                    it_.assign(off_.begin(), off_.end() - 1);
+                    for (int s = 0; s < m; ++s) {
+                        if (side[s] != 1) continue;
+                        // caminos de aumento por DFS iterativo sobre el grafo de niveles
+                        for (;;) {
+                            stack_.assign(1, { s, -1 });
+                            while (!stack_.empty() && side[stack_.back().first] != 2) {
+                                int x = stack_.back().first;
+                                int& k = it_[x];
+                                while (k < off_[x + 1] && !(level_[to_[k]] == level_[x] + 1 && residual(x, k) > 0)) ++k;
+                                if (k == off_[x + 1]) { level_[x] = -1; stack_.pop_back(); if (!stack_.empty()) ++it_[stack_.back().first]; continue; }
+                                stack_.push_back({ to_[k], k });
+                            }
+                            if (stack_.empty()) break;
+                            for (size_t i = 1; i < stack_.size(); ++i) push(stack_[i - 1].first, stack_[i].second);
+                            ++total;
+                        }
+                    }
+                }
+                source.assign(m, 0);
+                for (int x : queue_) source[x] = 1; // ultima pasada de levels: alcanzables en el residual
+                return total;
+            }
+
+        public:
+            explicit Bisector(const Graph& g) : g_(g), local_(g.vertexCount(), -1) {}
+
+            void bisect(const std::vector<int>& region, std::vector<int>& left, std::vector<int>& right) {
+                int m = (int)region.size();
+                for (int i = 0; i < m; ++i) local_[region[i]] = i;
+                // aristas no dirigidas (cada una una vez, desde su extremo menor) y CSR con ambas copias
+                eu_.clear(); ev_.clear();
+                off_.assign(m + 1, 0);
+                for (int i = 0; i < m; ++i) {
+                    for (const auto& e : g_.neighborsAt(region[i])) {
+                        int j = local_[e.slot];
+                        if (j <= i) continue;
+                        eu_.push_back(i); ev_.push_back(j);
+                        ++off_[i + 1]; ++off_[j + 1];
+                    }
+                }
+                for (int i = 0; i < m; ++i) off_[i + 1] += off_[i];
+                to_.resize(off_[m]); edge_.resize(off_[m]);
+                it_.assign(off_.begin(), off_.end() - 1);
+                for (int e = 0; e < (int)eu_.size(); ++e) {
+                    int k = it_[eu_[e]]++; to_[k] = ev_[e]; edge_[k] = e;
+                    k = it_[ev_[e]]++; to_[k] = eu_[e]; edge_[k] = e;
+                }
+                flow_.assign(eu_.size(), 0);
+
+                // raices: a lejos de 0, b lejos de a, c lejos de ambos
+                bfsOrder(0, m);
+                int a = order_.back();
+                bfsOrder(a, m);
+                std::vector<int> fromA = order_, distA = dist_;
+                int b = order_.back();
+                bfsOrder(b, m);
+                int c = a, best = -1;
+                for (int x = 0; x < m; ++x) {
+                    int d = std::min(distA[x], dist_[x]);
+                    if (d > best) { best = d; c = x; }
+                }
+                bfsOrder(c, m);
+
+                int terminals = std::max(1, (int)(m * Terminal));
+                std::vector<char> side(m), source, bestSide;
+                int bestCut = -1;
+                for (const auto* order : { &fromA, &order_ }) {
+                    std::fill(side.begin(), side.end(), 0);
+                    for (int i = 0; i < terminals; ++i) { side[(*order)[i]] = 1; side[(*order)[m - 1 - i]] = 2; }
+                    int cutEdges = minCut(side, m, source);
+                    if (bestCut < 0 || cutEdges < bestCut) { bestCut = cutEdges; bestSide.swap(source); }
+                }
+
+                left.clear(); right.clear();
+                for (int i = 0; i < m; ++i) (bestSide[i] ? left : right).push_back(region[i]);
+                for (int v : region) local_[v] = -1;
+            }
+        };
+
+        static void split(Bisector& cut, const std::vector<int>& region, const std::vector<int>& cellSizes, std::vector<int> current,
+            std::vector<std::vector<int>>& cellOf, std::vector<int>& count) {
+            int L = (int)cellSizes.size();
+            for (int l = 0; l < L; ++l) {
+                if (current[l] < 0 && (int)region.size() <= cellSizes[l]) current[l] = count[l]++;
+            }
+            if ((int)region.size() <= cellSizes[0] || region.size() < 2) {
+                for (int l = 0; l < L; ++l) {
+                    if (current[l] < 0) current[l] = count[l]++; // cellSizes[0] < 2
+                    for (int v : region) cellOf[l][v] = current[l];
+                }
+                return;
+            }
+            std::vector<int> left, right;
+            cut.bisect(region, left, right);
+            split(cut, left, cellSizes, current, cellOf, count);
+            split(cut, right, cellSizes, current, cellOf, count);
+        }
+
+        struct Change {
+            int u, v;   // slots de los extremos del tramo
+            bool up;    // solo subio (o se cerro)
+        };
+
+        // filas a recalcular en cada celda con cambios: si en la celda solo subieron costos, las
+        // filas cuyo arbol no usa ningun tramo cambiado conservan sus distancias; si alguno bajo
+        // (o no hay arboles en el nivel) todas. Suma a 'cells' las celdas con cambios.
+        static std::vector<std::pair<int, int>> dirtyRows(const Partition& p, const Metric& m, int level, std::vector<Change>& changes, int& cells) {
+            const auto& cell = p.cellOf[level];
+            const auto& idx = m.overlayIdx[level];
+            std::sort(changes.begin(), changes.end(), [&](const Change& a, const Change& b) { return cell[a.u] < cell[b.u]; });
+            std::vector<std::pair<int, int>> rows;
+            for (size_t a = 0, b = 0; a < changes.size(); a = b) {
+                int c = cell[changes[a].u];
+                ++cells;
+                bool up = !m.tree[level].empty();
+                for (b = a; b < changes.size() && cell[changes[b].u] == c; ++b) up = up && changes[b].up;
+                int B = m.boundaryOffsets[level][c + 1] - m.boundaryOffsets[level][c];
+                int V = m.overlayOffsets[level][c + 1] - m.overlayOffsets[level][c];
+                for (int i = 0; i < B; ++i) {
+                    bool used = !up;
+                    const std::uint16_t* tree = up ? &m.tree[level][m.treeOffsets[level][c] + (size_t)i * V] : nullptr;
+                    for (size_t k = a; k < b && !used; ++k) {
+                        int x = idx[changes[k].u], y = idx[changes[k].v];
+                        used = tree[x] == y || tree[y] == x;
+                    }
+                    if (used) rows.push_back({ c, i });
+                }
+            }
+            return rows;
+        }
+
+        static bool sameTopology(const Graph& g, const Metric& m) {
+            int n = g.vertexCount();
+            if ((int)m.snapOffsets.size() != n + 1) return false;
+            for (int u = 0; u < n; ++u) {
+                const auto& now = g.neighborsAt(u);
+                if ((int)now.size() != m.snapOffsets[u + 1] - m.snapOffsets[u]) return false;
+                const Graph::AdjEdge* old = m.snapEdges.data() + m.snapOffsets[u];
+                for (size_t k = 0; k < now.size(); ++k) if (now[k].slot != old[k].slot) return false;
+            }
+            return true;
+        }
+
+        static void takeSnapshot(const Graph& g, Metric& m) {
+            int n = g.vertexCount();
+            m.snapOffsets.assign(n + 1, 0);
+            m.snapEdges.clear();
+            for (int u = 0; u < n; ++u) {
+                const auto& l = g.neighborsAt(u);
+                m.snapEdges.insert(m.snapEdges.end(), l.begin(), l.end());
+                m.snapOffsets[u + 1] = (int)m.snapEdges.size();
+            }
+        }
+
+        static void buildBoundaries(const Graph& g, const Partition& p, Metric& m) {
+            int n = g.vertexCount(), L = p.levels();
+            m.boundaryOffsets.assign(L, {});
+            m.boundary.assign(L, {});
+            m.boundaryIdx.assign(L, std::vector<int>(n, -1));
+            m.cliqueOffsets.assign(L, {});
+            m.clique.assign(L, {});
+            m.overlayOffsets.assign(L, {});
+            m.overlay.assign(L, {});
+            m.overlayIdx.assign(L, std::vector<int>(n, -1));
+            m.treeOffsets.assign(L, {});
+            m.tree.assign(L, {});
+            for (int l = 0; l < L; ++l) {
+                const auto& cell = p.cellOf[l];
+                std::vector<int> count(p.cellCount[l] + 1, 0);
+                for (int u = 0; u < n; ++u) {
+                    for (const auto& e : g.neighborsAt(u)) {
+                        if (cell[e.slot] != cell[u]) { m.boundaryIdx[l][u] = 0; break; }
+                    }
+                    if (m.boundaryIdx[l][u] == 0) ++count[cell[u] + 1];
+                }
+                for (int c = 0; c < p.cellCount[l]; ++c) count[c + 1] += count[c];
+                m.boundaryOffsets[l] = count;
+                m.boundary[l].assign(count.back(), -1);
+                std::vector<int> fill(count.begin(), count.end() - 1);
+                for (int u = 0; u < n; ++u) {
+                    if (m.boundaryIdx[l][u] < 0) continue;
+                    int c = cell[u];
+                    m.boundaryIdx[l][u] = fill[c] - count[c];
+                    m.boundary[l][fill[c]++] = u;
+                }
+                m.cliqueOffsets[l].assign(p.cellCount[l] + 1, 0);
+                for (int c = 0; c < p.cellCount[l]; ++c) {
+                    size_t B = (size_t)(count[c + 1] - count[c]);
+                    m.cliqueOffsets[l][c + 1] = m.cliqueOffsets[l][c] + B * B;
+                }
+                m.clique[l].assign(m.cliqueOffsets[l].back(), std::numeric_limits<double>::infinity());
+
+                std::vector<int> members(p.cellCount[l] + 1, 0);
+                for (int u = 0; u < n; ++u) if (l == 0 || m.boundaryIdx[l - 1][u] >= 0) ++members[cell[u] + 1];
+                for (int c = 0; c < p.cellCount[l]; ++c) members[c + 1] += members[c];
+                m.overlayOffsets[l] = members;
+                m.overlay[l].assign(members.back(), -1);
+                std::vector<int> next(members.begin(), members.end() - 1);
+                for (int u = 0; u < n; ++u) {
+                    if (l > 0 && m.boundaryIdx[l - 1][u] < 0) continue;
+                    m.overlayIdx[l][u] = next[cell[u]] - members[cell[u]];
+                    m.overlay[l][next[cell[u]]++] = u;
+                }
+                m.treeOffsets[l].assign(p.cellCount[l] + 1, 0);
+                bool narrow = true;
+                for (int c = 0; c < p.cellCount[l]; ++c) {
+                    size_t B = (size_t)(count[c + 1] - count[c]), V = (size_t)(members[c + 1] - members[c]);
+                    narrow = narrow && V < Metric::NoParent;
+                    m.treeOffsets[l][c + 1] = m.treeOffsets[l][c] + B * V;
+                }
+                if (narrow) m.tree[l].assign(m.treeOffsets[l].back(), Metric::NoParent);
+            }
+        }
+
+        // Dijkstra restringido a la celda 'cell' del nivel 'level': en el nivel 0 sobre las aristas
+        // originales; en niveles mayores sobre el overlay del nivel inferior (cliques de las
+        // subceldas + aristas originales entre subceldas). Corta cuando done(u) devuelve true.
+        template <typename Done>
+        static void cellSearch(const Graph& g, const Partition& p, const Metric& m, int level, int cell, int from, SearchWorkspace& ws, Done done) {
+            const auto& inCell = p.cellOf[level];
+            ws.reset(p.n);
+            ws.set(from, 0.0, -1);
+            ws.heap.pushOrDecrease(from, 0.0);
+            while (!ws.heap.empty()) {
+                auto [du, u] = ws.heap.pop();
+                ws.settle(u);
+                if (done(u)) break;
+                auto relax = [&](int v, double w) {
+                    double nd = du + w;
+                    if (!ws.settled(v) && nd < ws.dist(v)) { ws.set(v, nd, u); ws.heap.pushOrDecrease(v, nd); }
+                    };
+                if (level == 0) {
+                    for (const auto& e : g.neighborsAt(u)) {
+                        if (!e.closed && inCell[e.slot] == cell) relax(e.slot, e.w);
+                    }
+                    continue;
+                }
+                const auto& sub = p.cellOf[level - 1];
+                int sc = sub[u], pu = ws.parent(u);
+                // llegado por el clique de su subcelda: ese clique ya cumple la desigualdad
+                // triangular, asi que quien lo relajo llego igual o mejor a toda la subcelda
+                if (pu < 0 || sub[pu] != sc) {
+                    int begin = m.boundaryOffsets[level - 1][sc], end = m.boundaryOffsets[level - 1][sc + 1];
+                    const double* row = &m.clique[level - 1][m.cliqueOffsets[level - 1][sc] + (size_t)(m.boundaryIdx[level - 1][u]) * (end - begin)];
+                    for (int k = begin; k < end; ++k) {
+                        if (!std::isinf(row[k - begin])) relax(m.boundary[level - 1][k], row[k - begin]);
+                    }
+                }
+                for (const auto& e : g.neighborsAt(u)) {
+                    if (!e.closed && inCell[e.slot] == cell && sub[e.slot] != sc) relax(e.slot, e.w);
+                }
+            }
+        }
+
+        // fila i del clique de la celda: distancias a los vertices frontera j > i. El grafo es no
+        // dirigido, asi que tambien llena la columna i; filas distintas escriben celdas distintas.
+        // Si 'changed' no es nulo agrega ahi las entradas que cambiaron.
+        static void customizeRow(const Graph& g, const Partition& p, Metric& m, int level, int cell, int i, SearchWorkspace& ws, std::vector<Change>* changed) {
+            int begin = m.boundaryOffsets[level][cell], end = m.boundaryOffsets[level][cell + 1];
+            int B = end - begin;
+            double* out = &m.clique[level][m.cliqueOffsets[level][cell]];
+            const auto& local = m.boundaryIdx[level];
+            const auto& inCell = p.cellOf[level];
+            int pending = B - 1 - i;
+            cellSearch(g, p, m, level, cell, m.boundary[level][begin + i], ws, [&](int u) {
+                if (local[u] > i && inCell[u] == cell) --pending;
+                return pending <= 0;
+                });
+            out[(size_t)i * B + i] = 0.0;
+            for (int j = i + 1; j < B; ++j) {
+                double d = ws.dist(m.boundary[level][begin + j]), old = out[(size_t)i * B + j];
+                if (changed && d != old) changed->push_back({ m.boundary[level][begin + i], m.boundary[level][begin + j], d > old });
+                out[(size_t)i * B + j] = d;
+                out[(size_t)j * B + i] = d;
+            }
+            if (m.tree[level].empty()) return;
+            int ob = m.overlayOffsets[level][cell], V = m.overlayOffsets[level][cell + 1] - ob;
+            std::uint16_t* tree = &m.tree[level][m.treeOffsets[level][cell] + (size_t)i * V];
+            for (int k = 0; k < V; ++k) {
+                int parent = ws.parent(m.overlay[level][ob + k]);
+                tree[k] = parent < 0 ? Metric::NoParent : (std::uint16_t)m.overlayIdx[level][parent];
+            }
+        }
+
+        // nivel del overlay que usa u en una consulta s-t: el mas alto cuya celda no contiene ni s ni t
+        // (-1: misma celda base que s o t -> aristas originales)
+        static int queryLevel(const Partition& p, int u, int s, int t) {
+            for (int l = p.levels() - 1; l >= 0; --l) {
+                const auto& c = p.cellOf[l];
+                if (c[u] != c[s] && c[u] != c[t]) return l;
+            }
+            return -1;
+        }
+
+        // agrega a 'out' el camino original de a a b (sin a) dentro de la celda, bajando de nivel.
+        // El arbol de la fila menor entre a y b llega hasta la otra (customizeRow corta despues).
+        static void unpack(const Graph& g, const Partition& p, const Metric& m, int level, int a, int b, SearchWorkspace& ws, std::vector<int>& out) {
+            if (m.tree[level].empty()) { unpackBySearch(g, p, m, level, a, b, ws, out); return; }
+            int c = p.cellOf[level][a];
+            int ia = m.boundaryIdx[level][a], ib = m.boundaryIdx[level][b];
+            int ob = m.overlayOffsets[level][c], V = m.overlayOffsets[level][c + 1] - ob;
+            const std::uint16_t* tree = &m.tree[level][m.treeOffsets[level][c] + (size_t)std::min(ia, ib) * V];
+            std::vector<int> seq;
+            for (int k = m.overlayIdx[level][ia < ib ? b : a]; k != Metric::NoParent; k = tree[k]) seq.push_back(m.overlay[level][ob + k]);
+            if (ia < ib) std::reverse(seq.begin(), seq.end()); // de a hacia b
+            for (size_t i = 1; i < seq.size(); ++i) {
+                int x = seq[i - 1], y = seq[i];
+                if (level > 0 && p.cellOf[level - 1][x] == p.cellOf[level - 1][y]) unpack(g, p, m, level - 1, x, y, ws, out);
+                else out.push_back(y);
+            }
+        }
+
+        static void unpackBySearch(const Graph& g, const Partition& p, const Metric& m, int level, int a, int b, SearchWorkspace& ws, std::vector<int>& out) {
+            cellSearch(g, p, m, level, p.cellOf[level][a], a, ws, [b](int u) { return u == b; });
+            std::vector<int> seq;
+            for (int cur = b; cur != -1; cur = ws.parent(cur)) seq.push_back(cur);
+            std::reverse(seq.begin(), seq.end());
+            for (size_t i = 1; i < seq.size(); ++i) {
+                int x = seq[i - 1], y = seq[i];
+                if (level > 0 && p.cellOf[level - 1][x] == p.cellOf[level - 1][y]) unpackBySearch(g, p, m, level - 1, x, y, ws, out);
+                else out.push_back(y);
+            }
+        }
+
+        static PathResult query(const Graph& g, const Partition& p, const Metric& m, int srcId, int dstId, SearchWorkspace& fw, SearchWorkspace& bw) {
+            if (!p.validFor(g) || !m.validFor(g)) {
+                auto r = Dijkstra::bidirectional(g, srcId, dstId, fw, bw);
+                r.algo = "CRP->BidirectionalDijkstra"; // falta customizar los cambios del grafo
+                return r;
+            }
+            PathResult res; res.algo = "CRP";
+            int s = g.indexOf(srcId), t = g.indexOf(dstId);
+            if (s < 0 || t < 0) return res;
+
+            const double INF = std::numeric_limits<double>::infinity();
+            fw.reset(p.n); bw.reset(p.n);
+            fw.set(s, 0.0, -1); fw.heap.pushOrDecrease(s, 0.0);
+            bw.set(t, 0.0, -1); bw.heap.pushOrDecrease(t, 0.0);
+            double mu = s == t ? 0.0 : INF;
+            int meet = s == t ? s : -1;
+
+            auto step = [&](SearchWorkspace& self, const SearchWorkspace& other) {
+                auto [du, u] = self.heap.pop();
+                self.settle(u);
+                auto relax = [&](int v, double w) {
+                    double nd = du + w;
+                    if (self.settled(v) || !(nd < self.dist(v))) return;
+                    self.set(v, nd, u);
+                    self.heap.pushOrDecrease(v, nd);
+                    if (other.reached(v) && nd + other.dist(v) < mu) { mu = nd + other.dist(v); meet = v; }
+                    };
+                int l = queryLevel(p, u, s, t);
+                if (l < 0) {
+                    for (const auto& e : g.neighborsAt(u)) if (!e.closed) relax(e.slot, e.w);
+                    return;
+                }
+                int c = p.cellOf[l][u], pu = self.parent(u);
+                if (pu < 0 || p.cellOf[l][pu] != c) { // mismo criterio que cellSearch
+                    int begin = m.boundaryOffsets[l][c], end = m.boundaryOffsets[l][c + 1];
+                    const double* row = &m.clique[l][m.cliqueOffsets[l][c] + (size_t)m.boundaryIdx[l][u] * (end - begin)];
+                    for (int k = begin; k < end; ++k) {
+                        if (!std::isinf(row[k - begin])) relax(m.boundary[l][k], row[k - begin]);
+                    }
+                }
+                for (const auto& e : g.neighborsAt(u)) {
+                    if (!e.closed && p.cellOf[l][e.slot] != c) relax(e.slot, e.w);
+                }
+                };
+
+            for (;;) {
+                double tf = fw.heap.empty() ? INF : fw.heap.top().first;
+                double tb = bw.heap.empty() ? INF : bw.heap.top().first;
+                if (tf + tb >= mu || (std::isinf(tf) && std::isinf(tb))) break;
+                if (tf <= tb) step(fw, bw); else step(bw, fw);
+            }
+            if (meet < 0) return res; // unreachable
+
+            // camino en el overlay: s .. meet .. t; cada tramo lo relajo el vertice mas cercano a su raiz
+            std::vector<std::pair<int, int>> hops; // (quien relajo, el otro extremo)
+            std::vector<int> fwd;
+            for (int cur = meet; cur != -1; cur = fw.parent(cur)) fwd.push_back(cur);
+            std::reverse(fwd.begin(), fwd.end());
+            for (size_t i = 1; i < fwd.size(); ++i) hops.push_back({ fwd[i - 1], fwd[i] });
+            std::vector<char> backward(hops.size(), 0);
+            for (int cur = meet; bw.parent(cur) != -1; cur = bw.parent(cur)) { hops.push_back({ bw.parent(cur), cur }); backward.push_back(1); }
+
+            std::vector<int> path{ s };
+            SearchWorkspace& ws = fw; // fw/bw ya no se necesitan
+            for (size_t i = 0; i < hops.size(); ++i) {
+                auto [by, other] = hops[i];
+                int from = backward[i] ? other : by, to = backward[i] ? by : other;
+                int l = queryLevel(p, by, s, t);
+                if (l >= 0 && p.cellOf[l][by] == p.cellOf[l][other]) unpack(g, p, m, l, from, to, ws, path);
+                else path.push_back(to);
+            }
+
+            res.reachable = true;
+            res.cost = mu;
+            res.path.reserve(path.size());
+            for (int v : path) res.path.push_back(g.idAt(v));
+            return res;
+        }
+    };
+
+} // namespace transport
@@ -0,0 +1 @@
+#include "CsrGraph.h"
@@ -0,0 +1,60 @@
+#pragma once
+#include <unordered_map>
+#include <vector>
+#include <cstdint>
+#include "Graph.h"
+
+namespace transport {
+
+    // Foto inmutable de Graph en formato CSR (compressed sparse row).
+    // Los vecinos del indice i estan en [offsets[i], offsets[i+1]) de targets/weights/closed,
+    // contiguos en memoria; los algoritmos de solo lectura recorren esto sin hash ni punteros.
+    class CsrGraph {
+    public:
+        std::vector<int> offsets;              // N+1
+        std::vector<int> targets;              // indice denso del vecino
+        std::vector<double> weights;
+        std::vector<std::uint8_t> closed;      // 1 = arista cerrada
+        std::vector<int> idOf;                 // idx -> vertexId
+        std::unordered_map<int, int> idxOf;    // vertexId -> idx
+        std::uint64_t sourceVersion = 0;       // Graph::version() al construir
+
+        static CsrGraph build(const Graph& g) {
+            CsrGraph c;
+            c.sourceVersion = g.version();
+            // el indice CSR coincide con el slot de Graph
+            int n = g.vertexCount();
+            c.idOf = g.ids();
+            c.idxOf.reserve(n);
+            size_t m = 0;
+            for (int i = 0; i < n; ++i) {
+                c.idxOf[c.idOf[i]] = i;
+                m += g.neighborsAt(i).size();
+            }
+
+            c.offsets.assign(n + 1, 0);
+            c.targets.reserve(m);
+            c.weights.reserve(m);
+            c.closed.reserve(m);
+            for (int i = 0; i < n; ++i) {
+                for (const auto& e : g.neighborsAt(i)) {
+                    c.targets.push_back(e.slot);
+                    c.weights.push_back(e.w);
+                    c.closed.push_back(e.closed ? 1 : 0);
+                }
+                c.offsets[i + 1] = (int)c.targets.size();
+            }
+            return c;
+        }
+
+        int vertexCount() const { return (int)idOf.size(); }
+        int edgeSlots() const { return (int)targets.size(); } // cada arista no dirigida cuenta 2 veces
+        bool hasVertex(int id) const { return idxOf.count(id) > 0; }
+        int indexOf(int id) const {
+            auto it = idxOf.find(id);
+            return it == idxOf.end() ? -1 : it->second;
+        }
+        int idAt(int idx) const { return idOf[idx]; }
+    };
+
+} // namespace transport
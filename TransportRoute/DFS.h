@@ -1,26 +1,93 @@
 #pragma once
-#include <unordered_set>
+#include <vector>
+#include <cstdint>
+#include <utility>
 #include "Result.h"
 #include "GraphView.h"
 
 namespace transport {
 
     class DFS {
-        static void dfs(const Graph& g, int u, std::unordered_set<int>& vis, VisitResult& res) {
-            vis.insert(u);
-            res.order.push_back(u);
-            forEachOpenNeighbor(g, u, [&](int v, double) {
-                if (!vis.count(v)) dfs(g, v, vis, res);
-                });
-        }
     public:
-        static VisitResult traverse(const Graph& g, int start) {
+        // arbol/bosque DFS por slot: tiempos de descubrimiento y cierre (un solo reloj) y padre
+        struct Forest {
+            std::vector<int> order;                  // ids en orden de descubrimiento
+            std::vector<int> discovery;              // slot -> tiempo (-1 = no visitado)
+            std::vector<int> finish;                 // slot -> tiempo de cierre
+            std::vector<int> parent;                 // slot -> slot padre (-1 = raiz o no visitado)
+        };
+
+    private:
+        // visitados como bits: N/8 bytes en lugar de N (o de un hash por vertice)
+        class Bitset {
+            std::vector<std::uint64_t> w_;
+        public:
+            explicit Bitset(int n) : w_(((size_t)n + 63) / 64, 0) {}
+            bool test(int i) const { return (w_[(size_t)i >> 6] >> (i & 63)) & 1u; }
+            void set(int i) { w_[(size_t)i >> 6] |= std::uint64_t(1) << (i & 63); }
+        };
+
+        // pila explicita de (vertice, cursor en su lista): mismo orden que la version recursiva
+        // (cada vecino se mira recien cuando se vuelve a u) sin depender del tamano del stack
+        template <typename G>
+        static void visit(const G& g, int s, Bitset& vis, Forest& f, int& clock, std::vector<std::pair<int, int>>& stack) {
+            vis.set(s);
+            f.order.push_back(g.idAt(s));
+            f.discovery[s] = clock++;
+            stack.emplace_back(s, 0);
+            while (!stack.empty()) {
+                auto& top = stack.back();
+                int u = top.first, v;
+                if (nextOpenNeighborAt(g, u, top.second, v)) {
+                    if (vis.test(v)) continue;
+                    vis.set(v);
+                    f.order.push_back(g.idAt(v));
+                    f.discovery[v] = clock++;
+                    f.parent[v] = u;
+                    stack.emplace_back(v, 0); // 'top' deja de ser valido
+                }
+                else {
+                    f.finish[u] = clock++;
+                    stack.pop_back();
+                }
+            }
+        }
+
+        template <typename G>
+        static Forest exploreIndexed(const G& g, int start, bool all) {
+            int n = g.vertexCount();
+            Forest f;
+            f.discovery.assign(n, -1);
+            f.finish.assign(n, -1);
+            f.parent.assign(n, -1);
+            Bitset vis(n);
+            std::vector<std::pair<int, int>> stack;
+            int clock = 0;
+            int s = g.indexOf(start);
+            if (s >= 0) visit(g, s, vis, f, clock, stack);
+            if (all) {
+                for (int v = 0; v < n; ++v) if (!vis.test(v)) visit(g, v, vis, f, clock, stack);
+            }
+            return f;
+        }
+
+        template <typename G>
+        static VisitResult traverseIndexed(const G& g, int start) {
             VisitResult res; res.algo = "DFS";
-            if (!g.hasVertex(start)) return res;
-            std::unordered_set<int> vis;
-            dfs(g, start, vis, res);
+            if (g.indexOf(start) < 0) return res;
+            res.order = exploreIndexed(g, start, false).order;
             return res;
         }
+    public:
+        static VisitResult traverse(const Graph& g, int start) { return traverseIndexed(g, start); }
+        static VisitResult traverse(const CsrGraph& g, int start) { return traverseIndexed(g, start); }
+
+        // arbol desde 'start' con tiempos y padres
+        static Forest explore(const Graph& g, int start) { return exploreIndexed(g, start, false); }
+        static Forest explore(const CsrGraph& g, int start) { return exploreIndexed(g, start, false); }
+        // bosque completo: 'start' primero (si existe) y despues cada componente en orden de slot
+        static Forest exploreAll(const Graph& g, int start = -1) { return exploreIndexed(g, start, true); }
+        static Forest exploreAll(const CsrGraph& g, int start = -1) { return exploreIndexed(g, start, true); }
     };
 
-} // namespace transport
\ No newline at end of file
+} // namespace transport
@@ -1,52 +1,178 @@
 #pragma once
-#include <queue>
-#include <unordered_map>
 #include <vector>
 #include <limits>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include "Result.h"
 #include "GraphView.h"
+#include "SearchWorkspace.h"
 
 namespace transport {
 
     class Dijkstra {
-    public:
-        static PathResult shortestPath(const Graph& g, int src, int dst) {
+        template <typename G>
+        static PathResult reconstruct(const G& g, int src, int dst, const SearchWorkspace& ws, PathResult res) {
+            if (!ws.reached(dst)) return res; // unreachable
+
+            // reconstruir camino
+            res.reachable = true;
+            res.cost = ws.dist(dst);
+            for (int cur = dst; ; cur = ws.parent(cur)) {
+                res.path.push_back(g.idAt(cur));
+                if (cur == src) break;
+            }
+            std::reverse(res.path.begin(), res.path.end());
+            return res;
+        }
+
+        template <typename G>
+        static PathResult shortestPathIndexed(const G& g, int srcId, int dstId, SearchWorkspace& ws) {
             PathResult res; res.algo = "Dijkstra";
-            if (!g.hasVertex(src) || !g.hasVertex(dst)) return res;
+            int src = g.indexOf(srcId), dst = g.indexOf(dstId);
+            if (src < 0 || dst < 0) return res;
 
-            std::unordered_map<int, double> dist;
-            std::unordered_map<int, int> parent;
+            ws.reset(g.vertexCount());
+            auto& pq = ws.heap;
+            ws.set(src, 0.0, -1);
+            pq.pushOrDecrease(src, 0.0);
 
-            struct Node { int v; double d; bool operator<(const Node& o) const { return d > o.d; } };
-            std::priority_queue<Node> pq;
+            while (!pq.empty()) {
+                auto [du, u] = pq.pop();
+                ws.settle(u);
+                if (u == dst) break;
+                forEachOpenNeighborAt(g, u, [&](int v, double w) {
+                    double nd = du + w;
+                    if (!ws.settled(v) && nd < ws.dist(v)) {
+                        ws.set(v, nd, u);
+                        pq.pushOrDecrease(v, nd);
+                    }
+                    });
+            }
+            return reconstruct(g, src, dst, ws, res);
+        }
+
+        // radix heap: la clave es round(dist * scale); exacto si los pesos son multiplos de 1/scale
+        template <typename G>
+        static PathResult shortestPathRadix(const G& g, int srcId, int dstId, SearchWorkspace& ws, double scale) {
+            PathResult res; res.algo = "Dijkstra(radix)";
+            int src = g.indexOf(srcId), dst = g.indexOf(dstId);
+            if (src < 0 || dst < 0) return res;
 
-            dist[src] = 0.0;
-            pq.push({ src, 0.0 });
+            ws.reset(g.vertexCount());
+            auto& pq = ws.radix;
+            auto keyOf = [scale](double d) { return (std::uint64_t)std::llround(d * scale); };
+            ws.set(src, 0.0, -1);
+            pq.push(0, src);
 
             while (!pq.empty()) {
-                auto [u, du] = pq.top(); pq.pop();
-                if (du != dist[u]) continue;
+                int u = pq.pop().second;
+                if (ws.settled(u)) continue; // entrada repetida
+                ws.settle(u);
                 if (u == dst) break;
-                forEachOpenNeighbor(g, u, [&](int v, double w) {
+                double du = ws.dist(u);
+                forEachOpenNeighborAt(g, u, [&](int v, double w) {
                     double nd = du + w;
-                    if (!dist.count(v) || nd < dist[v]) {
-                        dist[v] = nd; parent[v] = u; pq.push({ v, nd });
+                    if (!ws.settled(v) && nd < ws.dist(v)) {
+                        ws.set(v, nd, u);
+                        pq.push(keyOf(nd), v);
                     }
                     });
             }
+            return reconstruct(g, src, dst, ws, res);
+        }
 
-            if (!dist.count(dst)) return res; // unreachable
+        template <typename G>
+        static PathResult dispatch(const G& g, int src, int dst, SearchWorkspace& ws, HeapKind heap, double radixScale) {
+            return heap == HeapKind::Radix ? shortestPathRadix(g, src, dst, ws, radixScale)
+                : shortestPathIndexed(g, src, dst, ws);
+        }
+        // dos busquedas (desde src y desde dst, el grafo es no dirigido) que se encuentran;
+        // para cuando minF + minB >= mejor camino visto (mu)
+        template <typename G>
+        static PathResult bidirectionalIndexed(const G& g, int srcId, int dstId, SearchWorkspace& fw, SearchWorkspace& bw) {
+            PathResult res; res.algo = "BidirectionalDijkstra";
+            int src = g.indexOf(srcId), dst = g.indexOf(dstId);
+            if (src < 0 || dst < 0) return res;
 
-            // reconstruir camino
-            res.reachable = true;
-            res.cost = dist[dst];
-            for (int cur = dst; ; cur = parent[cur]) {
-                res.path.push_back(cur);
-                if (cur == src) break;
+            const double INF = std::numeric_limits<double>::infinity();
+            fw.reset(g.vertexCount());
+            bw.reset(g.vertexCount());
+            fw.set(src, 0.0, -1); fw.heap.pushOrDecrease(src, 0.0);
+            bw.set(dst, 0.0, -1); bw.heap.pushOrDecrease(dst, 0.0);
+            double mu = src == dst ? 0.0 : INF;
+            int meet = src == dst ? src : -1;
+
+            auto step = [&](SearchWorkspace& self, const SearchWorkspace& other) {
+                auto [du, u] = self.heap.pop();
+                self.settle(u);
+                forEachOpenNeighborAt(g, u, [&](int v, double w) {
+                    double nd = du + w;
+                    if (self.settled(v) || !(nd < self.dist(v))) return;
+                    self.set(v, nd, u);
+                    self.heap.pushOrDecrease(v, nd);
+                    if (other.reached(v) && nd + other.dist(v) < mu) { mu = nd + other.dist(v); meet = v; }
+                    });
+                };
+
+            while (!fw.heap.empty() && !bw.heap.empty()) {
+                if (fw.heap.top().first + bw.heap.top().first >= mu) break;
+                // expandir el lado con menos frontera
+                if (fw.heap.size() <= bw.heap.size()) step(fw, bw);
+                else step(bw, fw);
             }
+
+            if (meet < 0) return res; // unreachable
+
+            res.reachable = true;
+            res.cost = mu;
+            for (int cur = meet; cur != -1; cur = fw.parent(cur)) res.path.push_back(g.idAt(cur));
             std::reverse(res.path.begin(), res.path.end());
+            for (int cur = bw.parent(meet); cur != -1; cur = bw.parent(cur)) res.path.push_back(g.idAt(cur));
             return res;
         }
+    public:
+        // arbol completo de caminos minimos desde el indice denso 'src': deja dist/parent en ws
+        // y el orden de asentamiento en ws.queue (base para ALT, all-pairs, etc.)
+        template <typename G>
+        static void fullTree(const G& g, int src, SearchWorkspace& ws) {
+            ws.reset(g.vertexCount());
+            ws.set(src, 0.0, -1);
+            ws.heap.pushOrDecrease(src, 0.0);
+            while (!ws.heap.empty()) {
+                auto [du, u] = ws.heap.pop();
+                ws.settle(u);
+                ws.queue.push_back(u);
+                forEachOpenNeighborAt(g, u, [&](int v, double w) {
+                    double nd = du + w;
+                    if (!ws.settled(v) && nd < ws.dist(v)) {
+                        ws.set(v, nd, u);
+                        ws.heap.pushOrDecrease(v, nd);
+                    }
+                    });
+            }
+        }
+
+        static PathResult shortestPath(const Graph& g, int src, int dst) { SearchWorkspace ws; return shortestPathIndexed(g, src, dst, ws); }
+        static PathResult shortestPath(const CsrGraph& g, int src, int dst) { SearchWorkspace ws; return shortestPathIndexed(g, src, dst, ws); }
+
+        // reutilizan dist/parent/heap de 'ws' entre consultas
+        static PathResult shortestPath(const Graph& g, int src, int dst, SearchWorkspace& ws) { return shortestPathIndexed(g, src, dst, ws); }
+        static PathResult shortestPath(const CsrGraph& g, int src, int dst, SearchWorkspace& ws) { return shortestPathIndexed(g, src, dst, ws); }
+
+        // heap elegido por llamada; radixScale = unidades de punto fijo por unidad de peso
+        static PathResult shortestPath(const Graph& g, int src, int dst, SearchWorkspace& ws, HeapKind heap, double radixScale = 1.0) {
+            return dispatch(g, src, dst, ws, heap, radixScale);
+        }
+        static PathResult shortestPath(const CsrGraph& g, int src, int dst, SearchWorkspace& ws, HeapKind heap, double radixScale = 1.0) {
+            return dispatch(g, src, dst, ws, heap, radixScale);
+        }
+
+        // bidireccional: mismo contrato de PathResult; fw/bw son los workspaces de cada lado
+        static PathResult bidirectional(const Graph& g, int src, int dst) { SearchWorkspace fw, bw; return bidirectionalIndexed(g, src, dst, fw, bw); }
+        static PathResult bidirectional(const CsrGraph& g, int src, int dst) { SearchWorkspace fw, bw; return bidirectionalIndexed(g, src, dst, fw, bw); }
+        static PathResult bidirectional(const Graph& g, int src, int dst, SearchWorkspace& fw, SearchWorkspace& bw) { return bidirectionalIndexed(g, src, dst, fw, bw); }
+        static PathResult bidirectional(const CsrGraph& g, int src, int dst, SearchWorkspace& fw, SearchWorkspace& bw) { return bidirectionalIndexed(g, src, dst, fw, bw); }
     };
 
 } // namespace transport
@@ -1,26 +1,42 @@
 #pragma once
 #include <vector>
-#include <unordered_map>
+#include <utility>
 
 namespace transport {
 
+    // union-find sobre indices densos (slots de Graph / indices CSR).
+    // find iterativo con compresion por mitades y union por tamano: sin recursion y sin
+    // segunda pasada, profundidad O(log N) aunque no se comprima nunca.
     class DisjointSet {
-        std::unordered_map<int, int> parent;
-        std::unordered_map<int, int> rank;
+        std::vector<int> parent;
+        std::vector<int> size;
     public:
-        void makeSet(int x) { parent[x] = x; rank[x] = 0; }
+        DisjointSet() = default;
+        explicit DisjointSet(int n) : parent(n), size(n, 1) {
+            for (int i = 0; i < n; ++i) parent[i] = i;
+        }
+        void makeSet(int x) {
+            if (x >= (int)parent.size()) { parent.resize(x + 1); size.resize(x + 1, 1); }
+            parent[x] = x; size[x] = 1;
+        }
         int find(int x) {
-            if (parent[x] == x) return x;
-            return parent[x] = find(parent[x]);
+            while (parent[x] != x) { parent[x] = parent[parent[x]]; x = parent[x]; }
+            return x;
+        }
+        // sin escrituras: se puede llamar desde varios hilos mientras nadie une
+        int root(int x) const {
+            while (parent[x] != x) x = parent[x];
+            return x;
         }
         bool unite(int a, int b) {
             a = find(a); b = find(b);
             if (a == b) return false;
-            if (rank[a] < rank[b]) std::swap(a, b);
+            if (size[a] < size[b]) std::swap(a, b);
             parent[b] = a;
-            if (rank[a] == rank[b]) rank[a]++;
+            size[a] += size[b];
             return true;
         }
+        int componentSize(int x) const { return size[root(x)]; }
     };
 
 } // namespace transport
@@ -0,0 +1 @@
+#include "DistanceTable.h"
@@ -0,0 +1,119 @@
+#pragma once
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <cstdint>
+#include "Result.h"
+#include "Graph.h"
+#include "CsrGraph.h"
+#include "GraphView.h"
+#include "Parallel.h"
+#include "SearchWorkspace.h"
+
+namespace transport {
+
+    // Matriz origen-destino (uno-a-muchos / muchos-a-muchos): un Dijkstra por origen que se corta
+    // cuando ya se cerraron todos los destinos, los origenes en paralelo. Mucho mas barato que
+    // un Dijkstra por par cuando hay cientos de origenes y miles de destinos.
+    class DistanceTable {
+    public:
+        struct Table {
+            std::vector<int> sources;               // ids de origen (filas)
+            std::vector<int> targets;               // ids de destino (columnas)
+            std::vector<double> dist;               // rows x cols, fila-mayor (infinito = sin camino)
+            // opcional: padre de cada vertice en el arbol de cada origen (rows x N, -1 = no alcanzado)
+            std::vector<int> parent;
+            std::vector<int> idOf;                  // slot -> vertexId (para reconstruir caminos)
+            std::vector<int> targetSlot;            // slot de cada destino (-1 = no existe)
+            int n = 0;
+
+            int rows() const { return (int)sources.size(); }
+            int cols() const { return (int)targets.size(); }
+            bool hasPaths() const { return !parent.empty(); }
+            double at(int i, int j) const { return dist[(size_t)i * cols() + j]; }
+
+            // camino de sources[i] a targets[j] (requiere withPaths)
+            PathResult path(int i, int j) const {
+                PathResult res; res.algo = "DistanceTable";
+                double d = at(i, j);
+                if (d == std::numeric_limits<double>::infinity() || !hasPaths()) return res;
+                res.reachable = true;
+                res.cost = d;
+                const int* par = parent.data() + (size_t)i * n;
+                for (int cur = targetSlot[j]; cur != -1; cur = par[cur]) res.path.push_back(idOf[cur]);
+                std::reverse(res.path.begin(), res.path.end());
+                return res;
+            }
+        };
+
+        // threads <= 0: todos los nucleos
+        static Table compute(const Graph& g, const std::vector<int>& sources, const std::vector<int>& targets, bool withPaths = false, int threads = 0) {
+            return computeIndexed(g, sources, targets, withPaths, threads);
+        }
+        static Table compute(const CsrGraph& g, const std::vector<int>& sources, const std::vector<int>& targets, bool withPaths = false, int threads = 0) {
+            return computeIndexed(g, sources, targets, withPaths, threads);
+        }
+
+    private:
+        template <typename G>
+        static Table computeIndexed(const G& g, const std::vector<int>& sources, const std::vector<int>& targets, bool withPaths, int threads) {
+            const double INF = std::numeric_limits<double>::infinity();
+            int n = g.vertexCount();
+            Table t;
+            t.sources = sources;
+            t.targets = targets;
+            t.n = n;
+            t.dist.assign(sources.size() * targets.size(), INF);
+            if (withPaths) {
+                t.idOf.resize(n);
+                for (int i = 0; i < n; ++i) t.idOf[i] = g.idAt(i);
+                t.parent.assign(sources.size() * (size_t)n, -1);
+            }
+
+            // destinos como slots; los repetidos cuentan una sola vez para el corte
+            std::vector<int>& targetSlot = t.targetSlot;
+            targetSlot.resize(targets.size());
+            std::vector<std::uint8_t> isTarget(n, 0);
+            int distinct = 0;
+            for (size_t j = 0; j < targets.size(); ++j) {
+                targetSlot[j] = g.indexOf(targets[j]);
+                if (targetSlot[j] >= 0 && !isTarget[targetSlot[j]]) { isTarget[targetSlot[j]] = 1; ++distinct; }
+            }
+
+            std::vector<SearchWorkspace> ws(workerCount(threads));
+            parallelFor(0, (int)sources.size(), [&](int i, int w) {
+                int src = g.indexOf(sources[i]);
+                if (src < 0) return;
+                SearchWorkspace& s = ws[w];
+                s.reset(n);
+                s.set(src, 0.0, -1);
+                s.heap.pushOrDecrease(src, 0.0);
+                int remaining = distinct;
+                while (!s.heap.empty() && remaining > 0) {
+                    auto [du, u] = s.heap.pop();
+                    s.settle(u);
+                    s.queue.push_back(u);
+                    if (isTarget[u] && --remaining == 0) break; // todos los destinos cerrados
+                    forEachOpenNeighborAt(g, u, [&](int v, double wt) {
+                        double nd = du + wt;
+                        if (!s.settled(v) && nd < s.dist(v)) {
+                            s.set(v, nd, u);
+                            s.heap.pushOrDecrease(v, nd);
+                        }
+                        });
+                }
+                double* row = t.dist.data() + (size_t)i * targets.size();
+                for (size_t j = 0; j < targets.size(); ++j) {
+                    int v = targetSlot[j];
+                    if (v >= 0 && s.settled(v)) row[j] = s.dist(v);
+                }
+                if (withPaths) {
+                    int* par = t.parent.data() + (size_t)i * n;
+                    for (int v : s.queue) par[v] = s.parent(v);
+                }
+                }, (int)ws.size());
+            return t;
+        }
+    };
+
+} // namespace transport
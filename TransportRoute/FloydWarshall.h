@@ -2,8 +2,24 @@
 #include <unordered_map>
 #include <vector>
 #include <limits>
+#include <algorithm>
+#include <tuple>
+#include <cmath>
 #include "Result.h"
 #include "GraphView.h"
+#include "Parallel.h"
+#include "SearchWorkspace.h"
+#include "Dijkstra.h"
+
+// min-plus de relaxTile con intrinsecos: SSE2 es la base de x64 (y de x86 con /arch:SSE2);
+// AVX2 solo si el compilador ya genera AVX2 (/arch:AVX2, -mavx2). Otro destino: lazo escalar.
+#if defined(__AVX2__)
+#define TRANSPORT_FW_AVX2 1
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TRANSPORT_FW_SSE2 1
+#include <emmintrin.h>
+#endif
 
 namespace transport {
 
@@ -13,69 +29,307 @@ namespace transport {
             // map de indice compacto -> id de vertice y viceversa
             std::vector<int> idOf;                      // idx -> vertexId
             std::unordered_map<int, int> idxOf;          // vertexId -> idx
-            std::vector<std::vector<double>> dist;      // NxN
-            std::vector<std::vector<int>> next;         // NxN (indice del siguiente)
+            int n = 0;
+            std::vector<double> dist;                   // NxN fila-mayor: dist[s*n + t]
+            std::vector<int> next;                      // NxN fila-mayor (indice del siguiente)
+
+            double distAt(int s, int t) const { return dist[(size_t)s * n + t]; }
+            int nextAt(int s, int t) const { return next[(size_t)s * n + t]; }
 
             PathResult path(int srcId, int dstId) const {
                 PathResult res; res.algo = "FloydWarshall";
                 auto itS = idxOf.find(srcId), itD = idxOf.find(dstId);
                 if (itS == idxOf.end() || itD == idxOf.end()) return res;
                 int s = itS->second, t = itD->second;
-                if (next[s][t] == -1) return res;
+                if (nextAt(s, t) == -1) return res;
                 res.reachable = true;
-                res.cost = dist[s][t];
+                res.cost = distAt(s, t);
                 int u = s;
                 res.path.push_back(idOf[u]);
                 while (u != t) {
-                    u = next[u][t];
+                    u = nextAt(u, t);
                     res.path.push_back(idOf[u]);
                 }
                 return res;
             }
         };
 
-        static AllPairs compute(const Graph& g) {
-            // compactar ids
-            std::vector<int> ids;
-            ids.reserve(g.data().size());
-            for (const auto& kv : g.data()) ids.push_back(kv.first);
+        // threads <= 0: todos los nucleos
+        static AllPairs compute(const Graph& g, int threads = 0) { return computeIndexed(g, threads); }
+        static AllPairs compute(const CsrGraph& g, int threads = 0) { return computeIndexed(g, threads); }
+
+        // Mismo resultado con un Dijkstra por origen (estilo Johnson; los pesos ya son >= 0, no hace
+        // falta repesar): O(N * M log N) contra O(N^3), mucho menos cuando la red es rala.
+        static AllPairs computeByDijkstra(const Graph& g, int threads = 0) { return computeRowsIndexed(g, threads); }
+        static AllPairs computeByDijkstra(const CsrGraph& g, int threads = 0) { return computeRowsIndexed(g, threads); }
+
+        // true si N Dijkstra cuestan menos que Floyd: M * log2(N) * sparseFactor < N^2
+        // (sparseFactor compensa la constante del heap frente al lazo vectorizado de Floyd)
+        static bool preferDijkstra(const CsrGraph& g, double sparseFactor = SparseFactor) {
+            double n = g.vertexCount(), m = g.edgeSlots();
+            return n > 1 && m * std::log2(n) * sparseFactor < n * n;
+        }
+
+        struct UpdateStats {
+            int decreased = 0;        // pares u-v que se abarataron (nuevas, reabiertas, peso menor)
+            int increased = 0;        // pares u-v que se encarecieron (cerradas, quitadas, peso mayor)
+            int rowsRecomputed = 0;   // filas/columnas recalculadas con Dijkstra
+            bool full = false;        // no se pudo actualizar: recomputar todo
+        };
+
+        // Lleva ap (calculado sobre 'before', mismos slots) al estado actual de g comparando el peso
+        // efectivo (minima arista abierta) de cada par u-v. Subidas: se recalculan con Dijkstra solo
+        // las filas cuyo arbol (via next) usa la arista; bajadas: relajacion O(N^2) por la arista.
+        // Si cambio la cantidad de vertices o hay demasiadas filas afectadas devuelve full = true.
+        static UpdateStats update(AllPairs& ap, const CsrGraph& before, const Graph& g, int threads = 0) {
+            UpdateStats st;
+            int n = ap.n;
+            if (g.vertexCount() != n || before.vertexCount() != n) { st.full = true; return st; }
+
+            std::vector<std::pair<int, int>> up;
+            std::vector<std::tuple<int, int, double>> down;
+            std::vector<std::pair<int, double>> oldW, newW;
+            const double INF = std::numeric_limits<double>::infinity();
+            for (int u = 0; u < n; ++u) {
+                oldW.clear(); newW.clear();
+                for (int k = before.offsets[u]; k < before.offsets[u + 1]; ++k) {
+                    if (before.targets[k] > u) oldW.push_back({ before.targets[k], before.closed[k] ? INF : before.weights[k] });
+                }
+                for (const auto& e : g.neighborsAt(u)) if (e.slot > u) newW.push_back({ e.slot, e.closed ? INF : e.w });
+                if (oldW == newW) continue;
+                collapse(oldW); collapse(newW);
+                size_t i = 0, j = 0;
+                while (i < oldW.size() || j < newW.size()) {
+                    int v; double wo = INF, wn = INF;
+                    if (j == newW.size() || (i < oldW.size() && oldW[i].first < newW[j].first)) { v = oldW[i].first; wo = oldW[i++].second; }
+                    else if (i == oldW.size() || newW[j].first < oldW[i].first) { v = newW[j].first; wn = newW[j++].second; }
+                    else { v = oldW[i].first; wo = oldW[i++].second; wn = newW[j++].second; }
+                    if (wn < wo) down.push_back({ u, v, wn });
+                    else if (wn > wo) up.push_back({ u, v });
+                }
+            }
+            st.decreased = (int)down.size();
+            st.increased = (int)up.size();
+
+            // primero las subidas, con Dijkstra sobre el grafo actual
+            if (!up.empty()) {
+                std::vector<char> affected(n, 0);
+                for (int t = 0; t < n; ++t) {
+                    const int* nt = ap.next.data() + t; // columna t: siguiente salto hacia t
+                    for (const auto& [u, v] : up) {
+                        if (nt[(size_t)u * n] == v || nt[(size_t)v * n] == u) { affected[t] = 1; break; }
+                    }
+                }
+                std::vector<int> rows;
+                for (int t = 0; t < n; ++t) if (affected[t]) rows.push_back(t);
+                if ((int)rows.size() * 2 > n) { st.full = true; return st; } // mas barato recomputar
+                recomputeRows(ap, g, rows, threads);
+                st.rowsRecomputed = (int)rows.size();
+            }
+            for (const auto& [u, v, w] : down) relaxThrough(ap, u, v, w, threads);
+            return st;
+        }
+
+    private:
+        // pares (vecino, peso) ordenados, uno por vecino con el menor peso
+        static void collapse(std::vector<std::pair<int, double>>& l) {
+            std::sort(l.begin(), l.end());
+            l.erase(std::unique(l.begin(), l.end(), [](const auto& a, const auto& b) { return a.first == b.first; }), l.end());
+        }
 
-            int n = (int)ids.size();
+        // la arista u-v ahora pesa w (menos que antes): d(i,j) = min(d(i,j), d(i,u)+w+d(v,j), d(i,v)+w+d(u,j)).
+        // Un camino minimo usa la arista a lo sumo una vez, asi que alcanzan las filas u y v previas.
+        static void relaxThrough(AllPairs& ap, int u, int v, double w, int threads) {
+            int n = ap.n;
+            std::vector<double> du(ap.dist.begin() + (size_t)u * n, ap.dist.begin() + (size_t)(u + 1) * n);
+            std::vector<double> dv(ap.dist.begin() + (size_t)v * n, ap.dist.begin() + (size_t)(v + 1) * n);
+            std::vector<int> toU(n), toV(n); // siguiente salto de i hacia u / v
+            for (int i = 0; i < n; ++i) { toU[i] = ap.next[(size_t)i * n + u]; toV[i] = ap.next[(size_t)i * n + v]; }
+
+            parallelFor(0, n, [&](int i, int) {
+                double diu = du[i], div = dv[i]; // simetrica: d(i,u) = d(u,i)
+                if (std::isinf(diu) && std::isinf(div)) return;
+                int viaU = i == u ? v : toU[i], viaV = i == v ? u : toV[i];
+                double* di = ap.dist.data() + (size_t)i * n;
+                int* ni = ap.next.data() + (size_t)i * n;
+                for (int j = 0; j < n; ++j) {
+                    double a = diu + w + dv[j], b = div + w + du[j];
+                    if (a < di[j] && a <= b) { di[j] = a; ni[j] = viaU; }
+                    else if (b < di[j]) { di[j] = b; ni[j] = viaV; }
+                }
+                }, threads);
+        }
+
+        // filas t completas con un Dijkstra desde t; por simetria tambien la columna t
+        // (next[i][t] = padre de i en el arbol de t)
+        static void recomputeRows(AllPairs& ap, const Graph& g, const std::vector<int>& rows, int threads) {
+            int n = ap.n, k = (int)rows.size();
+            std::vector<int> parents((size_t)k * n, -1);
+            std::vector<SearchWorkspace> ws(workerCount(threads));
+            parallelFor(0, k, [&](int r, int w) {
+                int t = rows[r];
+                SearchWorkspace& s = ws[w];
+                treeRow(ap, g, t, s, parents.data() + (size_t)r * n);
+                }, (int)ws.size());
+            // columnas, por filas para no pisar escrituras entre hilos; las filas recalculadas ya estan
+            std::vector<char> done(n, 0);
+            for (int t : rows) done[t] = 1;
+            parallelFor(0, n, [&](int i, int) {
+                if (done[i]) return;
+                double* di = ap.dist.data() + (size_t)i * n;
+                int* ni = ap.next.data() + (size_t)i * n;
+                for (int r = 0; r < k; ++r) {
+                    int t = rows[r];
+                    di[t] = ap.dist[(size_t)t * n + i];
+                    ni[t] = parents[(size_t)r * n + i];
+                }
+                }, threads);
+        }
+
+        // fila t con un Dijkstra desde t: dist y primer salto; par (opcional) recibe los padres
+        template <typename G>
+        static void treeRow(AllPairs& ap, const G& g, int t, SearchWorkspace& s, int* par) {
+            int n = ap.n;
+            Dijkstra::fullTree(g, t, s);
+            double* dt = ap.dist.data() + (size_t)t * n;
+            int* nt = ap.next.data() + (size_t)t * n;
+            std::fill(dt, dt + n, std::numeric_limits<double>::infinity());
+            std::fill(nt, nt + n, -1);
+            for (int v : s.queue) { // orden de cierre: el padre ya tiene su primer salto
+                int p = s.parent(v);
+                dt[v] = s.dist(v);
+                nt[v] = p < 0 ? v : (p == t ? v : nt[p]);
+                if (par) par[v] = p < 0 ? v : p;
+            }
+        }
+
+        // N Dijkstra (uno por fila) en paralelo: cada hilo escribe solo sus filas
+        template <typename G>
+        static AllPairs computeRowsIndexed(const G& g, int threads) {
+            int n = g.vertexCount();
             AllPairs ap;
-            ap.idOf = ids;
-            for (int i = 0; i < n; ++i) ap.idxOf[ids[i]] = i;
+            ap.n = n;
+            ap.idOf.resize(n);
+            ap.idxOf.reserve(n);
+            for (int i = 0; i < n; ++i) { ap.idOf[i] = g.idAt(i); ap.idxOf[ap.idOf[i]] = i; }
+            ap.dist.resize((size_t)n * n);
+            ap.next.resize((size_t)n * n);
+            std::vector<SearchWorkspace> ws(workerCount(threads));
+            parallelFor(0, n, [&](int t, int w) { treeRow(ap, g, t, ws[w], nullptr); }, (int)ws.size());
+            return ap;
+        }
+
+        static constexpr int Tile = 64; // 64x64 doubles = 32 KB por bloque
+        static constexpr double SparseFactor = 3.0; // cruce medido: N^2 / (M log2 N) entre 2 y 3
+
+        // G denso (slots de Graph / indices CSR): el indice compacto es el mismo
+        template <typename G>
+        static AllPairs computeIndexed(const G& g, int threads) {
+            int n = g.vertexCount();
+            AllPairs ap;
+            ap.n = n;
+            ap.idOf.resize(n);
+            ap.idxOf.reserve(n);
+            for (int i = 0; i < n; ++i) { ap.idOf[i] = g.idAt(i); ap.idxOf[ap.idOf[i]] = i; }
 
             const double INF = std::numeric_limits<double>::infinity();
-            ap.dist.assign(n, std::vector<double>(n, INF));
-            ap.next.assign(n, std::vector<int>(n, -1));
-            for (int i = 0; i < n; ++i) { ap.dist[i][i] = 0.0; ap.next[i][i] = i; }
+            ap.dist.assign((size_t)n * n, INF);
+            ap.next.assign((size_t)n * n, -1);
+            for (int i = 0; i < n; ++i) { ap.dist[(size_t)i * n + i] = 0.0; ap.next[(size_t)i * n + i] = i; }
 
             // aristas abiertas
             for (int i = 0; i < n; ++i) {
-                int u = ids[i];
-                forEachOpenNeighbor(g, u, [&](int v, double w) {
-                    int j = ap.idxOf.at(v);
-                    if (w < ap.dist[i][j]) {
-                        ap.dist[i][j] = w;
-                        ap.next[i][j] = j;
+                forEachOpenNeighborAt(g, i, [&](int j, double w) {
+                    size_t ij = (size_t)i * n + j;
+                    if (w < ap.dist[ij]) {
+                        ap.dist[ij] = w;
+                        ap.next[ij] = j;
                     }
                     });
             }
+            run(ap, threads);
+            return ap;
+        }
 
-            // floyd
-            for (int k = 0; k < n; ++k) {
-                for (int i = 0; i < n; ++i) {
-                    if (ap.dist[i][k] == INF) continue;
-                    for (int j = 0; j < n; ++j) {
-                        double nd = ap.dist[i][k] + ap.dist[k][j];
-                        if (nd < ap.dist[i][j]) {
-                            ap.dist[i][j] = nd;
-                            ap.next[i][j] = ap.next[i][k];
-                        }
-                    }
+        // di[j] = min(di[j], dik + dk[j]) en [from, to); donde mejora, ni[j] = nik
+        static void minPlusRow(double* di, int* ni, const double* dk, double dik, int nik, int from, int to) {
+            int j = from;
+#if defined(TRANSPORT_FW_AVX2)
+            const __m256d vdik = _mm256_set1_pd(dik);
+            const __m128i vnik = _mm_set1_epi32(nik);
+            const __m256i pack = _mm256_setr_epi32(0, 2, 4, 6, 0, 0, 0, 0); // mascara 4x64 -> 4x32
+            for (; j + 4 <= to; j += 4) {
+                __m256d cur = _mm256_loadu_pd(di + j);
+                __m256d nd = _mm256_add_pd(vdik, _mm256_loadu_pd(dk + j));
+                __m256d lt = _mm256_cmp_pd(nd, cur, _CMP_LT_OQ);
+                _mm256_storeu_pd(di + j, _mm256_blendv_pd(cur, nd, lt));
+                __m128i m = _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(_mm256_castpd_si256(lt), pack));
+                __m128i nj = _mm_loadu_si128((const __m128i*)(ni + j));
+                _mm_storeu_si128((__m128i*)(ni + j), _mm_blendv_epi8(nj, vnik, m));
+            }
+#elif defined(TRANSPORT_FW_SSE2)
+            const __m128d vdik = _mm_set1_pd(dik);
+            const __m128i vnik = _mm_set1_epi32(nik);
+            for (; j + 4 <= to; j += 4) { // 4 por vuelta: las dos mascaras 2x64 forman una 4x32
+                __m128d cur0 = _mm_loadu_pd(di + j), cur1 = _mm_loadu_pd(di + j + 2);
+                __m128d nd0 = _mm_add_pd(vdik, _mm_loadu_pd(dk + j)), nd1 = _mm_add_pd(vdik, _mm_loadu_pd(dk + j + 2));
+                __m128 lt = _mm_shuffle_ps(_mm_castpd_ps(_mm_cmplt_pd(nd0, cur0)), _mm_castpd_ps(_mm_cmplt_pd(nd1, cur1)), _MM_SHUFFLE(2, 0, 2, 0));
+                _mm_storeu_pd(di + j, _mm_min_pd(nd0, cur0));
+                _mm_storeu_pd(di + j + 2, _mm_min_pd(nd1, cur1));
+                __m128i m = _mm_castps_si128(lt);
+                __m128i nj = _mm_loadu_si128((const __m128i*)(ni + j));
+                _mm_storeu_si128((__m128i*)(ni + j), _mm_or_si128(_mm_and_si128(m, vnik), _mm_andnot_si128(m, nj)));
+            }
+#endif
+            for (; j < to; ++j) {
+                double cur = di[j], nd = dik + dk[j];
+                ni[j] = nd < cur ? nik : ni[j];
+                di[j] = nd < cur ? nd : cur;
+            }
+        }
+
+        // min-plus sobre el bloque (I,J) con los k del bloque K. k va afuera: en la fase 1 y 2 el
+        // bloque se lee y escribe a la vez.
+        static void relaxTile(AllPairs& ap, int I, int J, int K) {
+            const double INF = std::numeric_limits<double>::infinity();
+            int n = ap.n;
+            int iEnd = std::min(I + Tile, n), jEnd = std::min(J + Tile, n), kEnd = std::min(K + Tile, n);
+            double* D = ap.dist.data();
+            int* N = ap.next.data();
+            for (int k = K; k < kEnd; ++k) {
+                const double* dk = D + (size_t)k * n;
+                for (int i = I; i < iEnd; ++i) {
+                    double* di = D + (size_t)i * n;
+                    double dik = di[k];
+                    if (dik == INF) continue;
+                    minPlusRow(di, N + (size_t)i * n, dk, dik, N[(size_t)i * n + k], J, jEnd);
                 }
             }
-            return ap;
+        }
+
+        // Floyd-Warshall por bloques: por cada bloque K, (1) el diagonal, (2) los de su fila y
+        // columna, (3) el resto; dentro de cada fase los bloques son independientes.
+        static void run(AllPairs& ap, int threads) {
+            int n = ap.n;
+            int tiles = (n + Tile - 1) / Tile;
+            for (int kb = 0; kb < tiles; ++kb) {
+                int K = kb * Tile;
+                relaxTile(ap, K, K, K);
+
+                parallelFor(0, 2 * tiles, [&](int t, int) {
+                    int b = t / 2;
+                    if (b == kb) return;
+                    if (t % 2 == 0) relaxTile(ap, K, b * Tile, K);   // fila K
+                    else relaxTile(ap, b * Tile, K, K);              // columna K
+                    }, threads);
+
+                parallelFor(0, tiles, [&](int ib, int) {             // una fila de bloques por tarea
+                    if (ib == kb) return;
+                    for (int jb = 0; jb < tiles; ++jb) {
+                        if (jb != kb) relaxTile(ap, ib * Tile, jb * Tile, K);
+                    }
+                    }, threads);
+            }
         }
     };
 
@@ -3,47 +3,104 @@
 #include <vector>
 #include <limits>
 #include <utility>
+#include <algorithm>
+#include <cstdint>
+#include "Connectivity.h"
 
 namespace transport {
 
     class Graph {
     public:
-        struct AdjEdge { int to; double w; bool closed; };
+        // slot = indice denso del vecino (ver indexOf), evita buscar 'to' en el hash
+        struct AdjEdge { int to; double w; bool closed; int slot; };
     private:
-        // adjacency list: id -> vector of edges
-        std::unordered_map<int, std::vector<AdjEdge>> adj_;
+        // cada id recibe un slot denso 0..N-1 estable (no se eliminan vertices)
+        std::vector<std::vector<AdjEdge>> adj_;  // slot -> aristas
+        std::vector<int> ids_;                   // slot -> id
+        std::unordered_map<int, int> slotOf_;    // id -> slot
+        // se incrementa en cada cambio; las fotos derivadas (CsrGraph, caches) lo comparan
+        std::uint64_t version_ = 0;
+        // se incrementa solo si algun camino pudo abaratarse (arista nueva/reabierta, peso menor);
+        // cotas inferiores precalculadas (ALT, CH) siguen validas mientras no cambie
+        std::uint64_t decreaseVersion_ = 0;
+        // componentes de las aristas abiertas; se mantiene en addEdge/setClosed/removeEdge
+        // (mutable: connected() rearma de forma perezosa tras cerrar una arista del bosque)
+        mutable DynamicConnectivity conn_;
+
+        int ensureSlot(int id) {
+            auto [it, inserted] = slotOf_.emplace(id, (int)ids_.size());
+            if (inserted) {
+                ids_.push_back(id);
+                adj_.emplace_back();
+                conn_.addVertex();
+                ++version_;
+            }
+            return it->second;
+        }
 
     public:
-        void clear() { adj_.clear(); }
+        void clear() { adj_.clear(); ids_.clear(); slotOf_.clear(); conn_.clear(); ++version_; ++decreaseVersion_; }
+        std::uint64_t version() const { return version_; }
+        std::uint64_t decreaseVersion() const { return decreaseVersion_; }
 
-        void addVertex(int id) {
-            (void)adj_[id]; // ensure key exists
-        }
+        void addVertex(int id) { ensureSlot(id); }
 
         void addEdge(int u, int v, double w, bool closed = false) {
-            addVertex(u); addVertex(v);
-            adj_[u].push_back({ v,w,closed });
-            adj_[v].push_back({ u,w,closed });
+            int su = ensureSlot(u), sv = ensureSlot(v);
+            adj_[su].push_back({ v,w,closed,sv });
+            adj_[sv].push_back({ u,w,closed,su });
+            ++version_;
+            if (!closed) { ++decreaseVersion_; conn_.insert(su, sv); }
         }
 
         bool setClosed(int u, int v, bool closed) {
-            bool touched = false;
-            auto itU = adj_.find(u), itV = adj_.find(v);
-            if (itU != adj_.end()) {
-                for (auto& e : itU->second) if (e.to == v) { e.closed = closed; touched = true; }
+            bool touched = false, reopened = false;
+            int su = indexOf(u), sv = indexOf(v);
+            if (su >= 0) {
+                for (auto& e : adj_[su]) if (e.to == v) { reopened |= e.closed && !closed; e.closed = closed; touched = true; }
+            }
+            if (sv >= 0) {
+                for (auto& e : adj_[sv]) if (e.to == u) { reopened |= e.closed && !closed; e.closed = closed; touched = true; }
             }
-            if (itV != adj_.end()) {
-                for (auto& e : itV->second) if (e.to == u) { e.closed = closed; touched = true; }
+            if (touched) ++version_;
+            if (reopened) ++decreaseVersion_;
+            if (touched && su >= 0 && sv >= 0) {
+                if (closed) conn_.erase(su, sv); // todas las aristas u-v quedaron cerradas
+                else conn_.insert(su, sv);
             }
             return touched;
         }
 
-        const std::unordered_map<int, std::vector<AdjEdge>>& data() const { return adj_; }
-        bool hasVertex(int id) const { return adj_.count(id) > 0; }
+        bool hasVertex(int id) const { return slotOf_.count(id) > 0; }
         const std::vector<AdjEdge>& neighbors(int id) const {
             static const std::vector<AdjEdge> empty;
-            auto it = adj_.find(id);
-            return it == adj_.end() ? empty : it->second;
+            int s = indexOf(id);
+            return s < 0 ? empty : adj_[s];
+        }
+
+        // acceso por slot
+        int vertexCount() const { return (int)ids_.size(); }
+        int indexOf(int id) const {
+            auto it = slotOf_.find(id);
+            return it == slotOf_.end() ? -1 : it->second;
+        }
+        int idAt(int slot) const { return ids_[slot]; }
+        const std::vector<int>& ids() const { return ids_; }      // slot -> id
+        const std::vector<AdjEdge>& neighborsAt(int slot) const { return adj_[slot]; }
+
+        // hay camino por aristas abiertas entre u y v: O(log N), salvo la primera consulta despues
+        // de cerrar/quitar una arista del bosque generador (rearma en O(V+E)).
+        // No llamar desde varios hilos a la vez si hubo cambios desde la ultima consulta.
+        bool connected(int u, int v) const {
+            int su = indexOf(u), sv = indexOf(v);
+            if (su < 0 || sv < 0) return false;
+            if (conn_.dirty()) {
+                conn_.rebuild(vertexCount(), [this](auto add) {
+                    for (int s = 0; s < vertexCount(); ++s)
+                        for (const auto& e : adj_[s]) if (!e.closed && s < e.slot) add(s, e.slot);
+                    });
+            }
+            return conn_.connected(su, sv);
         }
 
         bool removeEdge(int u, int v) {
@@ -53,24 +110,43 @@ namespace transport {
                 vec.erase(it, vec.end());
                 return changed;
                 };
-            auto itU = adj_.find(u), itV = adj_.find(v);
+            int su = indexOf(u), sv = indexOf(v);
             bool a = false, b = false;
-            if (itU != adj_.end()) a = rm(itU->second, v);
-            if (itV != adj_.end()) b = rm(itV->second, u);
+            if (su >= 0) a = rm(adj_[su], v);
+            if (sv >= 0) b = rm(adj_[sv], u);
+            if (a || b) ++version_;
+            if ((a || b) && su >= 0 && sv >= 0) conn_.erase(su, sv);
             return a || b;
         }
 
         bool setWeight(int u, int v, double w) {
+            bool touched = false, lowered = false;
+            int su = indexOf(u), sv = indexOf(v);
+            if (su >= 0) {
+                for (auto& e : adj_[su]) if (e.to == v) { lowered |= w < e.w; e.w = w; touched = true; }
+            }
+            if (sv >= 0) {
+                for (auto& e : adj_[sv]) if (e.to == u) { lowered |= w < e.w; e.w = w; touched = true; }
+            }
+            if (touched) ++version_;
+            if (lowered) ++decreaseVersion_;
+            return touched;
+        }
+
+        // suma delta al peso en ambas direcciones, solo si la arista no esta cerrada
+        bool adjustWeight(int u, int v, double delta) {
             bool touched = false;
-            auto itU = adj_.find(u), itV = adj_.find(v);
-            if (itU != adj_.end()) {
-                for (auto& e : itU->second) if (e.to == v) { e.w = w; touched = true; }
+            int su = indexOf(u), sv = indexOf(v);
+            if (su >= 0) {
+                for (auto& e : adj_[su]) if (e.to == v && !e.closed) { e.w += delta; touched = true; }
             }
-            if (itV != adj_.end()) {
-                for (auto& e : itV->second) if (e.to == u) { e.w = w; touched = true; }
+            if (sv >= 0) {
+                for (auto& e : adj_[sv]) if (e.to == u && !e.closed) { e.w += delta; touched = true; }
             }
+            if (touched) ++version_;
+            if (touched && delta < 0.0) ++decreaseVersion_;
             return touched;
         }
     };
 
-} // namespace transport
\ No newline at end of file
+} // namespace transport
@@ -1,5 +1,6 @@
 #pragma once
 #include "Graph.h"
+#include "CsrGraph.h"
 
 namespace transport {
 
@@ -15,4 +16,47 @@ namespace transport {
         }
     }
 
+    // por slot denso de Graph (fn recibe el slot del vecino, no id)
+    template <typename Fn>
+    inline void forEachOpenNeighborAt(const Graph& g, int u, Fn fn) {
+        for (const auto& e : g.neighborsAt(u)) {
+            if (!e.closed) fn(e.slot, e.w);
+        }
+    }
+
+    // CSR: recorre por indice denso (fn recibe indice del vecino, no id)
+    template <typename Fn>
+    inline void forEachOpenNeighborAt(const CsrGraph& g, int u, Fn fn) {
+        for (int k = g.offsets[u], end = g.offsets[u + 1]; k < end; ++k) {
+            if (!g.closed[k]) fn(g.targets[k], g.weights[k]);
+        }
+    }
+
+    // recorrido con cursor explicito: avanza 'cursor' (posicion en la lista de u, empieza en 0)
+    // hasta la proxima arista abierta y deja el vecino en v; false si no quedan
+    inline bool nextOpenNeighborAt(const Graph& g, int u, int& cursor, int& v) {
+        const auto& adj = g.neighborsAt(u);
+        while (cursor < (int)adj.size()) {
+            const auto& e = adj[cursor++];
+            if (!e.closed) { v = e.slot; return true; }
+        }
+        return false;
+    }
+
+    inline bool nextOpenNeighborAt(const CsrGraph& g, int u, int& cursor, int& v) {
+        for (int k = g.offsets[u] + cursor, end = g.offsets[u + 1]; k < end; ++k) {
+            ++cursor;
+            if (!g.closed[k]) { v = g.targets[k]; return true; }
+        }
+        return false;
+    }
+
+    // CSR con la misma firma por id que la version de Graph
+    template <typename Fn>
+    inline void forEachOpenNeighbor(const CsrGraph& g, int u, Fn fn) {
+        int i = g.indexOf(u);
+        if (i < 0) return;
+        forEachOpenNeighborAt(g, i, [&](int v, double w) { fn(g.idOf[v], w); });
+    }
+
 } // namespace transport
\ No newline at end of file
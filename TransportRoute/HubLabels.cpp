@@ -0,0 +1 @@
+#include "HubLabels.h"
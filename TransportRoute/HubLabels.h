@@ -0,0 +1,216 @@
+#pragma once
+#include <unordered_map>
+#include <vector>
+#include <cstdint>
+#include <limits>
+#include <algorithm>
+#include <utility>
+#include "Result.h"
+#include "Graph.h"
+#include "SearchWorkspace.h"
+#include "ContractionHierarchy.h"
+
+namespace transport {
+
+    // Hub labeling: cada vertice guarda (hub, distancia) y d(s,t) = min sobre hubs comunes de
+    // L(s) + L(t). Las etiquetas salen de pruned landmark labeling recorriendo los vertices en el
+    // orden de la jerarquia CH (los mas importantes primero). Memoria O(N * etiqueta) en lugar de
+    // NxN: reemplaza a FloydWarshall::AllPairs cuando N es grande.
+    class HubLabels {
+    public:
+        // bloques de 64 bytes: la etiqueta de cada vertice empieza en una linea de cache
+        struct alignas(64) HubLine { std::uint16_t w[32]; };
+        struct alignas(64) DistLine { double d[8]; };
+
+        struct Index {
+            std::vector<int> idOf;                   // slot -> vertexId
+            std::unordered_map<int, int> idxOf;      // vertexId -> slot
+            std::vector<int> hubSlot;                // rango de hub -> slot
+            // hubs de cada etiqueta ordenados por rango y codificados como deltas en uint16
+            // (delta 0 = escape: siguen 2 palabras con el delta de 32 bits)
+            std::vector<HubLine> hubs;
+            std::vector<DistLine> dist;
+            std::vector<int> parent;                 // opcional: vecino hacia el hub (mismo indice que dist)
+            std::vector<std::uint32_t> hubStart;     // por slot, en palabras uint16 (multiplo de 32)
+            std::vector<std::uint32_t> distStart;    // por slot, en doubles (multiplo de 8)
+            std::vector<std::uint32_t> count;        // entradas por slot
+            std::uint64_t version = 0;               // Graph::version() al construir
+
+            bool validFor(const Graph& g) const { return version == g.version() && (int)idOf.size() == g.vertexCount(); }
+            bool hasPaths() const { return !parent.empty(); }
+
+            size_t labelEntries() const {
+                size_t s = 0;
+                for (auto c : count) s += c;
+                return s;
+            }
+            size_t bytes() const {
+                return hubs.size() * sizeof(HubLine) + dist.size() * sizeof(DistLine) + parent.size() * sizeof(int)
+                    + (hubStart.size() + distStart.size() + count.size()) * sizeof(std::uint32_t);
+            }
+
+            double distance(int srcId, int dstId) const {
+                auto itS = idxOf.find(srcId), itD = idxOf.find(dstId);
+                if (itS == idxOf.end() || itD == idxOf.end()) return std::numeric_limits<double>::infinity();
+                return distanceAt(itS->second, itD->second).first;
+            }
+
+            // misma interfaz que AllPairs::path (requiere etiquetas con parent)
+            PathResult path(int srcId, int dstId) const {
+                PathResult res; res.algo = "HubLabels";
+                auto itS = idxOf.find(srcId), itD = idxOf.find(dstId);
+                if (itS == idxOf.end() || itD == idxOf.end()) return res;
+                int s = itS->second, t = itD->second;
+                auto [d, hub] = distanceAt(s, t);
+                if (hub < 0) return res; // unreachable
+                res.reachable = true;
+                res.cost = d;
+                if (!hasPaths()) return res;
+
+                std::vector<int> up = walkToHub(s, hub), down = walkToHub(t, hub);
+                for (int v : up) res.path.push_back(idOf[v]);
+                for (size_t i = down.size() - 1; i-- > 0;) res.path.push_back(idOf[down[i]]);
+                return res;
+            }
+
+            // (distancia, rango del hub que la realiza o -1)
+            std::pair<double, int> distanceAt(int s, int t) const {
+                double best = std::numeric_limits<double>::infinity();
+                int bestHub = -1;
+                const std::uint16_t* ps = words() + hubStart[s];
+                const std::uint16_t* pt = words() + hubStart[t];
+                const double* ds = dists() + distStart[s];
+                const double* dt = dists() + distStart[t];
+                std::uint32_t cs = count[s], ct = count[t], i = 0, j = 0;
+                if (cs == 0 || ct == 0) return { best, bestHub };
+                std::uint32_t hs = decode(ps, NoHub), ht = decode(pt, NoHub);
+                for (;;) {
+                    if (hs == ht) {
+                        double d = ds[i] + dt[j];
+                        if (d < best) { best = d; bestHub = (int)hs; }
+                        if (++i == cs || ++j == ct) break;
+                        hs = decode(ps, hs); ht = decode(pt, ht);
+                    }
+                    else if (hs < ht) { if (++i == cs) break; hs = decode(ps, hs); }
+                    else { if (++j == ct) break; ht = decode(pt, ht); }
+                }
+                return { best, bestHub };
+            }
+
+        private:
+            const std::uint16_t* words() const { return reinterpret_cast<const std::uint16_t*>(hubs.data()); }
+            const double* dists() const { return reinterpret_cast<const double*>(dist.data()); }
+
+            // posicion del hub en la etiqueta de v (las etiquetas estan ordenadas por rango)
+            int find(int v, std::uint32_t hub) const {
+                const std::uint16_t* p = words() + hubStart[v];
+                std::uint32_t h = NoHub;
+                for (std::uint32_t i = 0; i < count[v]; ++i) {
+                    h = decode(p, h);
+                    if (h == hub) return (int)i;
+                    if (h > hub) break;
+                }
+                return -1;
+            }
+
+            // v, ..., hub siguiendo parent (cada vertice del camino tiene el hub en su etiqueta)
+            std::vector<int> walkToHub(int v, int hub) const {
+                std::vector<int> out{ v };
+                while (v != hubSlot[hub]) {
+                    v = parent[distStart[v] + find(v, (std::uint32_t)hub)];
+                    out.push_back(v);
+                }
+                return out;
+            }
+        };
+
+        // withPaths = false ahorra el arreglo parent cuando solo se piden distancias
+        static Index build(const Graph& g, bool withPaths = true) {
+            int n = g.vertexCount();
+            Index idx;
+            idx.version = g.version();
+            idx.idOf = g.ids();
+            idx.idxOf.reserve(n);
+            for (int i = 0; i < n; ++i) idx.idxOf[idx.idOf[i]] = i;
+
+            // orden: rango CH descendente
+            auto h = CH::preprocess(g);
+            idx.hubSlot.resize(n);
+            for (int v = 0; v < n; ++v) idx.hubSlot[n - 1 - h.rank[v]] = v;
+
+            // pruned landmark labeling con etiquetas temporales sin comprimir
+            const double INF = std::numeric_limits<double>::infinity();
+            std::vector<std::vector<std::pair<int, double>>> labels(n);
+            std::vector<std::vector<int>> parents(withPaths ? n : 0);
+            std::vector<double> rootDist(n, INF); // por rango de hub: etiqueta de la raiz actual
+            SearchWorkspace ws;
+            for (int k = 0; k < n; ++k) {
+                int root = idx.hubSlot[k];
+                for (const auto& [hub, d] : labels[root]) rootDist[hub] = d;
+                ws.reset(n);
+                ws.set(root, 0.0, -1);
+                ws.heap.pushOrDecrease(root, 0.0);
+                while (!ws.heap.empty()) {
+                    auto [du, u] = ws.heap.pop();
+                    ws.settle(u);
+                    // poda: los hubs anteriores ya cubren (root, u)
+                    bool covered = false;
+                    for (const auto& [hub, d] : labels[u]) {
+                        if (rootDist[hub] + d <= du) { covered = true; break; }
+                    }
+                    if (covered) continue;
+                    labels[u].push_back({ k, du });
+                    if (withPaths) parents[u].push_back(ws.parent(u));
+                    for (const auto& e : g.neighborsAt(u)) {
+                        if (e.closed) continue;
+                        double nd = du + e.w;
+                        if (!ws.settled(e.slot) && nd < ws.dist(e.slot)) {
+                            ws.set(e.slot, nd, u);
+                            ws.heap.pushOrDecrease(e.slot, nd);
+                        }
+                    }
+                }
+                for (const auto& [hub, d] : labels[root]) rootDist[hub] = INF;
+            }
+
+            // comprimir: deltas de hubs + distancias, cada etiqueta alineada a 64 bytes
+            idx.hubStart.resize(n); idx.distStart.resize(n); idx.count.resize(n);
+            std::vector<std::uint16_t> w;
+            std::vector<double> d;
+            std::vector<int> par;
+            for (int v = 0; v < n; ++v) {
+                idx.hubStart[v] = (std::uint32_t)w.size();
+                idx.distStart[v] = (std::uint32_t)d.size();
+                idx.count[v] = (std::uint32_t)labels[v].size();
+                std::uint32_t prev = NoHub;
+                for (size_t i = 0; i < labels[v].size(); ++i) {
+                    std::uint32_t hub = (std::uint32_t)labels[v][i].first, delta = hub - prev;
+                    if (delta <= 0xFFFF) w.push_back((std::uint16_t)delta);
+                    else { w.push_back(0); w.push_back((std::uint16_t)(delta & 0xFFFF)); w.push_back((std::uint16_t)(delta >> 16)); }
+                    prev = hub;
+                    d.push_back(labels[v][i].second);
+                    if (withPaths) par.push_back(parents[v][i]);
+                }
+                w.resize((w.size() + 31) / 32 * 32, 0);
+                d.resize((d.size() + 7) / 8 * 8, INF);
+                if (withPaths) par.resize(d.size(), -1);
+            }
+            idx.hubs.resize(w.size() / 32);
+            idx.dist.resize(d.size() / 8);
+            if (!w.empty()) std::copy(w.begin(), w.end(), reinterpret_cast<std::uint16_t*>(idx.hubs.data()));
+            if (!d.empty()) std::copy(d.begin(), d.end(), reinterpret_cast<double*>(idx.dist.data()));
+            idx.parent = std::move(par);
+            return idx;
+        }
+
+    private:
+        static constexpr std::uint32_t NoHub = 0xFFFFFFFFu; // "rango -1": el primer delta es hub + 1
+
+        static std::uint32_t decode(const std::uint16_t*& p, std::uint32_t prev) {
+            std::uint32_t delta = *p++;
+            if (delta == 0) { delta = (std::uint32_t)p[0] | ((std::uint32_t)p[1] << 16); p += 2; }
+            return prev + delta;
+        }
+    };
+
+} // namespace transport
@@ -0,0 +1 @@
+#include "IndexedHeap.h"
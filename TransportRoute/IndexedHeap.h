@@ -0,0 +1,148 @@
+#pragma once
+#include <vector>
+#include <utility>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace transport {
+
+    // que cola de prioridad usa la busqueda
+    enum class HeapKind {
+        Dary,   // 4-ario indexado con decrease-key (pesos reales, por defecto)
+        Radix   // radix heap con claves enteras monotonas (pesos enteros / punto fijo)
+    };
+
+    // Min-heap D-ario indexado por vertice: cada vertice aparece a lo sumo una vez,
+    // decrease-key en O(log_D n) en vez de insertar duplicados.
+    template <int D = 4>
+    class IndexedDaryHeap {
+        std::vector<std::pair<double, int>> heap_; // (clave, vertice)
+        std::vector<int> pos_;                     // vertice -> posicion en heap_, -1 = fuera
+
+        void place(size_t i, const std::pair<double, int>& e) { heap_[i] = e; pos_[e.second] = (int)i; }
+
+        void siftUp(size_t i) {
+            auto e = heap_[i];
+            while (i > 0) {
+                size_t p = (i - 1) / D;
+                if (!(e.first < heap_[p].first)) break;
+                place(i, heap_[p]);
+                i = p;
+            }
+            place(i, e);
+        }
+
+        void siftDown(size_t i) {
+            auto e = heap_[i];
+            size_t n = heap_.size();
+            for (;;) {
+                size_t first = i * D + 1;
+                if (first >= n) break;
+                size_t last = first + D < n ? first + D : n;
+                size_t best = first;
+                for (size_t c = first + 1; c < last; ++c)
+                    if (heap_[c].first < heap_[best].first) best = c;
+                if (!(heap_[best].first < e.first)) break;
+                place(i, heap_[best]);
+                i = best;
+            }
+            place(i, e);
+        }
+
+    public:
+        // asegura espacio para vertices 0..n-1 (no vacia)
+        void reserve(int n) { if ((int)pos_.size() < n) pos_.resize(n, -1); }
+
+        bool empty() const { return heap_.empty(); }
+        size_t size() const { return heap_.size(); }
+        bool contains(int v) const { return v < (int)pos_.size() && pos_[v] >= 0; }
+        const std::pair<double, int>& top() const { return heap_.front(); }
+
+        // inserta v o baja su clave; devuelve false si la clave actual ya es <= key
+        bool pushOrDecrease(int v, double key) {
+            int p = pos_[v];
+            if (p < 0) {
+                heap_.push_back({ key, v });
+                pos_[v] = (int)heap_.size() - 1;
+                siftUp(heap_.size() - 1);
+                return true;
+            }
+            if (!(key < heap_[p].first)) return false;
+            heap_[p].first = key;
+            siftUp((size_t)p);
+            return true;
+        }
+
+        // fija la clave de v (sube o baja); inserta si no esta
+        void update(int v, double key) {
+            int p = pos_[v];
+            if (p < 0) { pushOrDecrease(v, key); return; }
+            double old = heap_[p].first;
+            heap_[p].first = key;
+            if (key < old) siftUp((size_t)p);
+            else siftDown((size_t)p);
+        }
+
+        std::pair<double, int> pop() {
+            auto top = heap_.front();
+            pos_[top.second] = -1;
+            auto last = heap_.back(); heap_.pop_back();
+            if (!heap_.empty()) { heap_[0] = last; siftDown(0); }
+            return top;
+        }
+
+        // O(elementos restantes): deja pos_ limpio para la proxima busqueda
+        void clear() {
+            for (const auto& e : heap_) pos_[e.second] = -1;
+            heap_.clear();
+        }
+    };
+
+    // Radix heap: claves enteras sin signo y monotonas (cada push >= ultima clave extraida),
+    // que es lo que garantiza Dijkstra con pesos no negativos. Admite duplicados (sin decrease-key).
+    class RadixHeap {
+        static constexpr int kBuckets = 65;
+        std::vector<std::pair<std::uint64_t, int>> buckets_[kBuckets];
+        std::uint64_t last_ = 0;
+        size_t size_ = 0;
+
+        static int bucketOf(std::uint64_t key, std::uint64_t last) {
+            std::uint64_t x = key ^ last;
+            int b = 0;
+            while (x) { ++b; x >>= 1; }
+            return b;
+        }
+
+    public:
+        bool empty() const { return size_ == 0; }
+        size_t size() const { return size_; }
+
+        void push(std::uint64_t key, int v) {
+            buckets_[bucketOf(key, last_)].push_back({ key, v });
+            ++size_;
+        }
+
+        std::pair<std::uint64_t, int> pop() {
+            if (buckets_[0].empty()) {
+                int i = 1;
+                while (buckets_[i].empty()) ++i;
+                std::uint64_t mn = std::numeric_limits<std::uint64_t>::max();
+                for (const auto& e : buckets_[i]) if (e.first < mn) mn = e.first;
+                last_ = mn;
+                for (const auto& e : buckets_[i]) buckets_[bucketOf(e.first, last_)].push_back(e);
+                buckets_[i].clear();
+            }
+            auto e = buckets_[0].back(); buckets_[0].pop_back();
+            --size_;
+            return e;
+        }
+
+        void clear() {
+            for (auto& b : buckets_) b.clear();
+            last_ = 0;
+            size_ = 0;
+        }
+    };
+
+} // namespace transport
@@ -0,0 +1 @@
+#include "Isochrone.h"
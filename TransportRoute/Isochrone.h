@@ -0,0 +1,134 @@
+#pragma once
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include "Graph.h"
+#include "CsrGraph.h"
+#include "GraphView.h"
+#include "Parallel.h"
+#include "SearchWorkspace.h"
+
+namespace transport {
+
+    // Isocronas: todo lo alcanzable desde un origen con costo <= maxCost y/o a lo sumo maxHops
+    // tramos. Dijkstra que no encola nada por encima del presupuesto, asi que el trabajo depende
+    // del tamano del resultado y no de la red (el workspace se limpia en O(1)).
+    // Con maxHops el camino mas barato puede usar demasiados tramos y uno mas caro no: se buscan
+    // estados (vertice, saltos) y de cada vertice se expanden solo las etiquetas que no estan
+    // dominadas (salen por costo, asi que basta con que usen menos saltos que las anteriores).
+    class Isochrone {
+    public:
+        struct Limits {
+            double maxCost = std::numeric_limits<double>::infinity();
+            int maxHops = -1;                        // < 0: sin limite
+        };
+
+        struct Reach {
+            int origin = -1;
+            std::vector<int> stations;               // ids en orden de costo (el origen primero)
+            std::vector<double> costs;
+            std::vector<int> hops;
+            size_t size() const { return stations.size(); }
+        };
+
+        static Reach compute(const Graph& g, int origin, const Limits& lim, SearchWorkspace& ws) { return computeIndexed(g, origin, lim, ws); }
+        static Reach compute(const CsrGraph& g, int origin, const Limits& lim, SearchWorkspace& ws) { return computeIndexed(g, origin, lim, ws); }
+        static Reach compute(const Graph& g, int origin, const Limits& lim) { SearchWorkspace ws; return computeIndexed(g, origin, lim, ws); }
+        static Reach compute(const CsrGraph& g, int origin, const Limits& lim) { SearchWorkspace ws; return computeIndexed(g, origin, lim, ws); }
+
+        // muchos origenes en paralelo, un workspace por hilo; threads <= 0: todos los nucleos
+        static std::vector<Reach> batch(const Graph& g, const std::vector<int>& origins, const Limits& lim, int threads = 0) {
+            return batchIndexed(g, origins, lim, threads);
+        }
+        static std::vector<Reach> batch(const CsrGraph& g, const std::vector<int>& origins, const Limits& lim, int threads = 0) {
+            return batchIndexed(g, origins, lim, threads);
+        }
+
+    private:
+        struct Label {
+            double d;
+            int hops;
+            int v;
+        };
+        // min-heap por costo; a igual costo, menos saltos primero
+        struct After {
+            bool operator()(const Label& a, const Label& b) const { return a.d != b.d ? a.d > b.d : a.hops > b.hops; }
+        };
+
+        template <typename G>
+        static Reach computeIndexed(const G& g, int originId, const Limits& lim, SearchWorkspace& ws) {
+            Reach r; r.origin = originId;
+            int src = g.indexOf(originId);
+            if (src < 0 || !(lim.maxCost >= 0.0)) return r;
+            if (lim.maxHops >= 0) return hopLimited(g, src, lim, ws, r);
+
+            ws.reset(g.vertexCount());
+            // saltos por vertice alcanzado; solo se leen entradas escritas en esta busqueda
+            thread_local std::vector<int> hopOf;
+            if ((int)hopOf.size() < g.vertexCount()) hopOf.resize(g.vertexCount());
+            ws.set(src, 0.0, -1);
+            hopOf[src] = 0;
+            ws.heap.pushOrDecrease(src, 0.0);
+            while (!ws.heap.empty()) {
+                auto [du, u] = ws.heap.pop();
+                ws.settle(u);
+                r.stations.push_back(g.idAt(u));
+                r.costs.push_back(du);
+                r.hops.push_back(hopOf[u]);
+                forEachOpenNeighborAt(g, u, [&](int v, double w) {
+                    double nd = du + w;
+                    if (nd > lim.maxCost || ws.settled(v) || !(nd < ws.dist(v))) return;
+                    ws.set(v, nd, u);
+                    hopOf[v] = hopOf[u] + 1;
+                    ws.heap.pushOrDecrease(v, nd);
+                    });
+            }
+            return r;
+        }
+
+        // Dijkstra sobre (vertice, saltos): cada vertice sale a lo sumo maxHops+1 veces. La primera
+        // da su costo minimo con <= maxHops tramos; las siguientes solo sirven si usan menos saltos
+        template <typename G>
+        static Reach hopLimited(const G& g, int src, const Limits& lim, SearchWorkspace& ws, Reach& r) {
+            ws.reset(g.vertexCount());
+            // menos saltos de una etiqueta ya expandida; valido solo si ws.settled(v)
+            thread_local std::vector<int> fewestHops;
+            thread_local std::vector<Label> heap;
+            if ((int)fewestHops.size() < g.vertexCount()) fewestHops.resize(g.vertexCount());
+            heap.clear();
+            heap.push_back(Label{ 0.0, 0, src });
+            while (!heap.empty()) {
+                std::pop_heap(heap.begin(), heap.end(), After());
+                Label l = heap.back();
+                heap.pop_back();
+                if (ws.settled(l.v)) {
+                    if (l.hops >= fewestHops[l.v]) continue; // dominada
+                }
+                else {
+                    ws.settle(l.v);
+                    r.stations.push_back(g.idAt(l.v));
+                    r.costs.push_back(l.d);
+                    r.hops.push_back(l.hops);
+                }
+                fewestHops[l.v] = l.hops;
+                if (l.hops == lim.maxHops) continue;
+                forEachOpenNeighborAt(g, l.v, [&](int v, double w) {
+                    double nd = l.d + w;
+                    if (nd > lim.maxCost || (ws.settled(v) && l.hops + 1 >= fewestHops[v])) return;
+                    heap.push_back(Label{ nd, l.hops + 1, v });
+                    std::push_heap(heap.begin(), heap.end(), After());
+                    });
+            }
+            return r;
+        }
+
+        template <typename G>
+        static std::vector<Reach> batchIndexed(const G& g, const std::vector<int>& origins, const Limits& lim, int threads) {
+            std::vector<Reach> out(origins.size());
+            std::vector<SearchWorkspace> ws(workerCount(threads));
+            parallelFor(0, (int)origins.size(), [&](int i, int w) { out[i] = computeIndexed(g, origins[i], lim, ws[w]); }, (int)ws.size());
+            return out;
+        }
+    };
+
+} // namespace transport
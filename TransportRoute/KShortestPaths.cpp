@@ -0,0 +1 @@
+#include "KShortestPaths.h"
@@ -0,0 +1,175 @@
+#pragma once
+#include <vector>
+#include <set>
+#include <queue>
+#include <limits>
+#include <algorithm>
+#include <cstdint>
+#include "Result.h"
+#include "Graph.h"
+#include "CsrGraph.h"
+#include "GraphView.h"
+#include "SearchWorkspace.h"
+#include "Dijkstra.h"
+
+namespace transport {
+
+    // K caminos minimos sin ciclos (Yen). Un solo Dijkstra inverso desde dst da d(v, dst) para
+    // todo v: cada busqueda de desvio es un A* con esa cota (sigue siendo consistente al quitar
+    // aristas) y, si el camino del arbol desde el nodo de desvio no toca nada bloqueado, se usa
+    // tal cual sin buscar. Los candidatos entran al heap con su cota inferior y solo se calculan
+    // cuando llegan al tope (heap perezoso): con K = 5..10 se resuelve una fraccion de ellos.
+    class KShortestPaths {
+    public:
+        static std::vector<PathResult> yen(const Graph& g, int src, int dst, int k) { SearchWorkspace t, w; return yenIndexed(g, src, dst, k, t, w); }
+        static std::vector<PathResult> yen(const CsrGraph& g, int src, int dst, int k) { SearchWorkspace t, w; return yenIndexed(g, src, dst, k, t, w); }
+        // tree: arbol inverso desde dst; ws: busquedas de desvio
+        static std::vector<PathResult> yen(const Graph& g, int src, int dst, int k, SearchWorkspace& tree, SearchWorkspace& ws) {
+            return yenIndexed(g, src, dst, k, tree, ws);
+        }
+        static std::vector<PathResult> yen(const CsrGraph& g, int src, int dst, int k, SearchWorkspace& tree, SearchWorkspace& ws) {
+            return yenIndexed(g, src, dst, k, tree, ws);
+        }
+
+    private:
+        struct Candidate {
+            double key;                  // cota inferior (sin resolver) o costo exacto
+            bool resolved;
+            int from;                    // camino aceptado del que se desvia
+            int spur;                    // posicion del nodo de desvio en ese camino
+            double cost;                 // costo de la raiz (sin resolver) o del camino completo
+            std::vector<int> path;       // slots (solo resueltos)
+        };
+        struct ByKey {
+            bool operator()(const Candidate& a, const Candidate& b) const {
+                if (a.key != b.key) return a.key > b.key;
+                return !a.resolved && b.resolved; // a igual costo, primero los resueltos
+            }
+        };
+
+        // peso de la arista abierta mas barata u-v
+        template <typename G>
+        static double edgeWeight(const G& g, int u, int v) {
+            double best = std::numeric_limits<double>::infinity();
+            forEachOpenNeighborAt(g, u, [&](int x, double w) { if (x == v && w < best) best = w; });
+            return best;
+        }
+
+        template <typename G>
+        static std::vector<PathResult> yenIndexed(const G& g, int srcId, int dstId, int k, SearchWorkspace& tree, SearchWorkspace& ws) {
+            std::vector<PathResult> out;
+            int src = g.indexOf(srcId), dst = g.indexOf(dstId);
+            if (src < 0 || dst < 0 || k <= 0) return out;
+            const int n = g.vertexCount();
+
+            // arbol inverso: tree.dist(v) = d(v, dst), tree.parent(v) = siguiente salto hacia dst
+            Dijkstra::fullTree(g, dst, tree);
+            if (!tree.reached(src)) return out;
+
+            std::vector<std::vector<int>> accepted;
+            std::vector<double> acceptedCost;
+            std::vector<int> deviation;  // desde donde se desvio de su padre (antes ya se cubrio)
+            std::set<std::vector<int>> seen;
+            std::priority_queue<Candidate, std::vector<Candidate>, ByKey> heap;
+
+            std::vector<std::uint32_t> blocked(n, 0);
+            std::uint32_t stamp = 0;
+            std::vector<int> blockedNext;
+
+            auto spawn = [&](int a) {
+                const auto& p = accepted[a];
+                double rootCost = 0.0;
+                for (int i = 0; i + 1 < (int)p.size(); ++i) {
+                    if (i >= deviation[a]) heap.push(Candidate{ rootCost + tree.dist(p[i]), false, a, i, rootCost, {} });
+                    rootCost += edgeWeight(g, p[i], p[i + 1]);
+                }
+            };
+            auto accept = [&](std::vector<int> path, double cost, int dev) {
+                seen.insert(path);
+                accepted.push_back(std::move(path));
+                acceptedCost.push_back(cost);
+                deviation.push_back(dev);
+                spawn((int)accepted.size() - 1);
+            };
+
+            {
+                std::vector<int> first;
+                for (int v = src; v != -1; v = tree.parent(v)) first.push_back(v);
+                accept(std::move(first), tree.dist(src), 0);
+            }
+
+            while ((int)accepted.size() < k && !heap.empty()) {
+                Candidate c = heap.top();
+                heap.pop();
+                if (c.resolved) {
+                    if (!seen.count(c.path)) accept(std::move(c.path), c.cost, c.spur);
+                    continue;
+                }
+
+                // resolver: raiz = camino aceptado hasta el nodo de desvio
+                const auto& base = accepted[c.from];
+                const int spurNode = base[c.spur];
+                if (++stamp == 0) { std::fill(blocked.begin(), blocked.end(), 0); stamp = 1; }
+                for (int i = 0; i < c.spur; ++i) blocked[base[i]] = stamp; // sin ciclos
+                blockedNext.clear();
+                for (const auto& p : accepted) {
+                    if ((int)p.size() > c.spur + 1 && std::equal(base.begin(), base.begin() + c.spur + 1, p.begin()))
+                        blockedNext.push_back(p[c.spur + 1]);
+                }
+                auto nextBlocked = [&](int v) { return std::find(blockedNext.begin(), blockedNext.end(), v) != blockedNext.end(); };
+
+                std::vector<int> spurPath;
+                double spurCost = std::numeric_limits<double>::infinity();
+                // atajo: el camino del arbol ya esquiva todo lo bloqueado -> es el minimo
+                bool treeOk = !nextBlocked(tree.parent(spurNode));
+                for (int v = tree.parent(spurNode); treeOk && v != -1; v = tree.parent(v)) treeOk = blocked[v] != stamp;
+                if (treeOk) {
+                    for (int v = spurNode; v != -1; v = tree.parent(v)) spurPath.push_back(v);
+                    spurCost = tree.dist(spurNode);
+                }
+                else {
+                    // A* con h = d(v, dst) del arbol inverso
+                    ws.reset(n);
+                    ws.set(spurNode, 0.0, -1);
+                    ws.heap.pushOrDecrease(spurNode, tree.dist(spurNode));
+                    while (!ws.heap.empty()) {
+                        int u = ws.heap.pop().second;
+                        ws.settle(u);
+                        if (u == dst) break;
+                        double du = ws.dist(u);
+                        forEachOpenNeighborAt(g, u, [&](int v, double w) {
+                            if (blocked[v] == stamp || (u == spurNode && nextBlocked(v)) || !tree.reached(v)) return;
+                            double nd = du + w;
+                            if (!ws.settled(v) && nd < ws.dist(v)) {
+                                ws.set(v, nd, u);
+                                ws.heap.pushOrDecrease(v, nd + tree.dist(v));
+                            }
+                            });
+                    }
+                    if (ws.settled(dst)) {
+                        spurCost = ws.dist(dst);
+                        for (int v = dst; v != -1; v = ws.parent(v)) spurPath.push_back(v);
+                        std::reverse(spurPath.begin(), spurPath.end());
+                    }
+                }
+                if (spurPath.empty()) continue; // no hay desvio desde aca
+
+                std::vector<int> full(base.begin(), base.begin() + c.spur);
+                full.insert(full.end(), spurPath.begin(), spurPath.end());
+                if (seen.count(full)) continue;
+                double rootCost = c.cost;
+                heap.push(Candidate{ rootCost + spurCost, true, c.from, c.spur, rootCost + spurCost, std::move(full) });
+            }
+
+            for (size_t i = 0; i < accepted.size(); ++i) {
+                PathResult r; r.algo = "Yen";
+                r.reachable = true;
+                r.cost = acceptedCost[i];
+                for (int v : accepted[i]) r.path.push_back(g.idAt(v));
+                out.push_back(std::move(r));
+            }
+            return out;
+        }
+    };
+
+} // namespace transport
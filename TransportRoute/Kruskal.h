@@ -1,39 +1,111 @@
 #pragma once
 #include <vector>
-#include <tuple>
 #include <algorithm>
 #include "DisjointSet.h"
 #include "Result.h"
 #include "GraphView.h"
+#include "Parallel.h"
 
 namespace transport {
 
+    // Filter-Kruskal (Osipov, Sanders, Singler): en lugar de ordenar todas las aristas, se
+    // parten alrededor de un pivote; primero se resuelven las livianas y de las pesadas solo se
+    // ordenan las que todavia unen componentes distintas. En grafos densos o de candidatos la
+    // mayoria de las pesadas se descarta sin ordenarse. El filtro y el orden de cada caso base
+    // corren en paralelo; las uniones son secuenciales.
     class Kruskal {
-    public:
-        static MSTResult mst(const Graph& g) {
-            MSTResult res; res.algo = "Kruskal";
-            // recolectar aristas abiertas u<v para no duplicar
-            std::vector<std::tuple<double, int, int>> edges;
-            for (const auto& [u, vec] : g.data()) {
-                for (const auto& e : vec) {
-                    if (e.closed) continue;
-                    if (u < e.to) edges.emplace_back(e.w, u, e.to);
-                }
-            }
-            std::sort(edges.begin(), edges.end(),
-                [](auto& a, auto& b) { return std::get<0>(a) < std::get<0>(b); });
+        struct Edge {
+            double w;
+            int u, v;
+        };
+        // (w, u, v): orden total, mismo arbol con cualquier cantidad de hilos
+        static bool lighter(const Edge& a, const Edge& b) {
+            if (a.w != b.w) return a.w < b.w;
+            if (a.u != b.u) return a.u < b.u;
+            return a.v < b.v;
+        }
 
+        static constexpr int BaseCase = 1 << 14;     // aristas: debajo de esto se ordena directo
+        static constexpr int FilterChunk = 1 << 14;  // aristas por tarea de filtrado
+        static constexpr int PivotSample = 31;
+
+        struct State {
             DisjointSet ds;
-            for (const auto& [u, _] : g.data()) ds.makeSet(u);
+            MSTResult* res;
+            int needed;                              // aristas que faltan (componentes - 1 como cota)
+            int base;                                // tamano del caso base
+            int threads;
+        };
 
-            for (const auto& [w, u, v] : edges) {
-                if (ds.unite(u, v)) {
-                    res.edges.emplace_back(u, v);
-                    res.totalWeight += w;
+        static void kruskalRange(Edge* first, Edge* last, State& st) {
+            parallelSort(first, last, lighter, st.threads);
+            for (Edge* e = first; e != last && st.needed > 0; ++e) {
+                if (st.ds.unite(e->u, e->v)) {
+                    st.res->edges.emplace_back(e->u, e->v);
+                    st.res->totalWeight += e->w;
+                    --st.needed;
                 }
             }
+        }
+
+        // deja al frente las aristas que unen componentes distintas; devuelve el nuevo fin
+        static Edge* filterRange(Edge* first, Edge* last, const State& st) {
+            long long n = last - first;
+            int chunks = (int)((n + FilterChunk - 1) / FilterChunk);
+            std::vector<long long> kept(chunks);
+            parallelFor(0, chunks, [&](int c, int) {
+                Edge* b = first + (long long)c * FilterChunk;
+                Edge* e = first + std::min(n, (long long)(c + 1) * FilterChunk);
+                kept[c] = std::remove_if(b, e, [&](const Edge& x) { return st.ds.root(x.u) == st.ds.root(x.v); }) - b;
+                }, chunks < 2 ? 1 : st.threads);
+            Edge* out = first;
+            for (int c = 0; c < chunks; ++c) {
+                Edge* b = first + (long long)c * FilterChunk;
+                if (out != b) std::move(b, b + kept[c], out);
+                out += kept[c];
+            }
+            return out;
+        }
+
+        static void filterKruskal(Edge* first, Edge* last, State& st) {
+            if (st.needed <= 0) return;
+            long long n = last - first;
+            if (n <= st.base) { kruskalRange(first, last, st); return; }
+
+            // pivote: mediana de una muestra equiespaciada
+            Edge sample[PivotSample];
+            for (int i = 0; i < PivotSample; ++i) sample[i] = first[n * i / PivotSample];
+            std::nth_element(sample, sample + PivotSample / 2, sample + PivotSample, lighter);
+            const Edge pivot = sample[PivotSample / 2];
+            Edge* mid = std::partition(first, last, [&](const Edge& e) { return !lighter(pivot, e); });
+            if (mid == last) { kruskalRange(first, last, st); return; } // todo igual al pivote
+
+            filterKruskal(first, mid, st);
+            if (st.needed <= 0) return;
+            filterKruskal(mid, filterRange(mid, last, st), st);
+        }
+
+        template <typename G>
+        static MSTResult mstIndexed(const G& g, int threads) {
+            MSTResult res; res.algo = "Kruskal";
+            int n = g.vertexCount();
+            // recolectar aristas abiertas u<v para no duplicar
+            std::vector<Edge> edges;
+            for (int u = 0; u < n; ++u) {
+                forEachOpenNeighborAt(g, u, [&](int v, double w) {
+                    if (u < v) edges.push_back(Edge{ w, u, v });
+                    });
+            }
+
+            State st{ DisjointSet(n), &res, n - 1, std::max(BaseCase, n), workerCount(threads) };
+            filterKruskal(edges.data(), edges.data() + edges.size(), st);
+            for (auto& e : res.edges) e = { g.idAt(e.first), g.idAt(e.second) };
             return res;
         }
+    public:
+        // bosque generador minimo (uno por componente); threads <= 0: todos
+        static MSTResult mst(const Graph& g, int threads = 0) { return mstIndexed(g, threads); }
+        static MSTResult mst(const CsrGraph& g, int threads = 0) { return mstIndexed(g, threads); }
     };
 
 } // namespace transport
@@ -0,0 +1 @@
+#include "LazyAllPairs.h"
@@ -0,0 +1,130 @@
+#pragma once
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <limits>
+#include <algorithm>
+#include <cstdint>
+#include "Result.h"
+#include "Graph.h"
+#include "CsrGraph.h"
+#include "SearchWorkspace.h"
+#include "Dijkstra.h"
+
+namespace transport {
+
+    // Todos-los-pares bajo demanda: el arbol de caminos minimos de cada origen se calcula con
+    // Dijkstra la primera vez que se consulta y queda en una LRU limitada por bytes.
+    // Misma interfaz path(src, dst) que FloydWarshall::AllPairs sin pagar NxN por adelantado.
+    // El grafo es no dirigido: una fila de dst tambien responde src -> dst (al reves).
+    // Si cambia graph.version() las filas guardadas se descartan en la siguiente consulta.
+    class LazyAllPairs {
+    public:
+        struct Stats {
+            std::uint64_t hits = 0;
+            std::uint64_t misses = 0;
+            std::uint64_t evictions = 0;
+        };
+
+        explicit LazyAllPairs(const Graph& g, size_t budgetBytes = size_t(64) << 20) : g_(&g), budget_(budgetBytes) {}
+
+        PathResult path(int srcId, int dstId) {
+            PathResult res; res.algo = "LazyAllPairs";
+            sync();
+            int s = csr_.indexOf(srcId), t = csr_.indexOf(dstId);
+            if (s < 0 || t < 0) return res;
+
+            // preferir una fila ya calculada (de s o, al reves, de t)
+            bool reversed = rows_.find(s) == rows_.end() && rows_.find(t) != rows_.end();
+            const Row& row = reversed ? touch(t) : touch(s);
+            int from = reversed ? t : s, to = reversed ? s : t;
+            if (row.parent[to] == -1 && to != from) return res; // unreachable
+
+            res.reachable = true;
+            res.cost = row.dist[to];
+            for (int cur = to; cur != -1; cur = row.parent[cur]) res.path.push_back(csr_.idAt(cur));
+            if (!reversed) std::reverse(res.path.begin(), res.path.end());
+            return res;
+        }
+
+        double distance(int srcId, int dstId) {
+            sync();
+            int s = csr_.indexOf(srcId), t = csr_.indexOf(dstId);
+            if (s < 0 || t < 0) return std::numeric_limits<double>::infinity();
+            if (rows_.find(s) == rows_.end() && rows_.find(t) != rows_.end()) return touch(t).dist[s];
+            return touch(s).dist[t];
+        }
+
+        // cambia el presupuesto; expulsa filas si ya no entran
+        void setBudget(size_t budgetBytes) { budget_ = budgetBytes; trim(0); }
+        size_t budget() const { return budget_; }
+
+        // true si el arbol de srcId esta guardado y sigue valido para el grafo actual
+        bool cached(int srcId) const {
+            if (!synced_ || csr_.sourceVersion != g_->version()) return false;
+            int s = csr_.indexOf(srcId);
+            return s >= 0 && rows_.count(s) > 0;
+        }
+        int cachedRows() const { return (int)rows_.size(); }
+        size_t rowBytes() const { return (size_t)csr_.vertexCount() * (sizeof(double) + sizeof(int)); }
+        size_t bytes() const { return rows_.size() * rowBytes(); }
+        const Stats& stats() const { return stats_; }
+
+        void clear() { rows_.clear(); lru_.clear(); }
+
+    private:
+        struct Row {
+            std::vector<double> dist;
+            std::vector<int> parent;
+            std::list<int>::iterator pos;    // lugar en lru_
+        };
+
+        const Graph* g_;
+        size_t budget_;
+        CsrGraph csr_;
+        bool synced_ = false;
+        std::unordered_map<int, Row> rows_;  // slot origen -> arbol
+        std::list<int> lru_;                 // mas reciente al frente
+        SearchWorkspace ws_;
+        Stats stats_;
+
+        void sync() {
+            if (synced_ && csr_.sourceVersion == g_->version()) return;
+            csr_ = CsrGraph::build(*g_);
+            synced_ = true;
+            clear();
+        }
+
+        // expulsa las menos usadas hasta que entren 'incoming' filas mas (siempre queda lugar para una)
+        void trim(size_t incoming) {
+            size_t rb = std::max<size_t>(1, rowBytes());
+            size_t maxRows = std::max<size_t>(1, budget_ / rb);
+            while (!lru_.empty() && rows_.size() + incoming > maxRows) {
+                rows_.erase(lru_.back());
+                lru_.pop_back();
+                ++stats_.evictions;
+            }
+        }
+
+        const Row& touch(int src) {
+            auto it = rows_.find(src);
+            if (it != rows_.end()) {
+                ++stats_.hits;
+                lru_.splice(lru_.begin(), lru_, it->second.pos);
+                return it->second;
+            }
+            ++stats_.misses;
+            trim(1);
+            int n = csr_.vertexCount();
+            Dijkstra::fullTree(csr_, src, ws_);
+            Row row;
+            row.dist.assign(n, std::numeric_limits<double>::infinity());
+            row.parent.assign(n, -1);
+            for (int v : ws_.queue) { row.dist[v] = ws_.dist(v); row.parent[v] = ws_.parent(v); }
+            lru_.push_front(src);
+            row.pos = lru_.begin();
+            return rows_.emplace(src, std::move(row)).first->second;
+        }
+    };
+
+} // namespace transport
@@ -56,11 +56,12 @@ void MapCanvas::refreshGraph() {
     clearGraph();
 
     // Crear aristas primero (para que estn detrs de los nodos)
-    const auto& graphData = controller->graph.data();
+    const auto& graph = controller->graph;
     std::set<std::pair<int, int>> processedEdges;
 
-    for (const auto& [u, edges] : graphData) {
-        for (const auto& edge : edges) {
+    for (int s = 0; s < graph.vertexCount(); ++s) {
+        int u = graph.idAt(s);
+        for (const auto& edge : graph.neighborsAt(s)) {
             int v = edge.to;
             if (u < v) { // Evitar duplicados
                 auto key = std::make_pair(u, v);
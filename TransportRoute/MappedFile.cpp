@@ -0,0 +1,63 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace transport {
+
+    MappedFile::~MappedFile() { close(); }
+
+#ifdef _WIN32
+    bool MappedFile::open(const std::string& path) {
+        close();
+        HANDLE f = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (f == INVALID_HANDLE_VALUE) return false;
+        LARGE_INTEGER sz{};
+        if (!GetFileSizeEx(f, &sz) || sz.QuadPart == 0) { CloseHandle(f); return false; }
+        HANDLE m = CreateFileMappingA(f, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!m) { CloseHandle(f); return false; }
+        void* p = MapViewOfFile(m, FILE_MAP_READ, 0, 0, 0);
+        if (!p) { CloseHandle(m); CloseHandle(f); return false; }
+        file_ = f; mapping_ = m;
+        data_ = static_cast<const std::uint8_t*>(p);
+        size_ = (size_t)sz.QuadPart;
+        return true;
+    }
+
+    void MappedFile::close() {
+        if (data_) UnmapViewOfFile(data_);
+        if (mapping_) CloseHandle((HANDLE)mapping_);
+        if (file_) CloseHandle((HANDLE)file_);
+        data_ = nullptr; size_ = 0; mapping_ = nullptr; file_ = nullptr;
+    }
+#else
+    bool MappedFile::open(const std::string& path) {
+        close();
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st {};
+        if (fstat(fd, &st) != 0 || st.st_size == 0) { ::close(fd); return false; }
+        void* p = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd); // el mapeo sigue valido
+        if (p == MAP_FAILED) return false;
+        data_ = static_cast<const std::uint8_t*>(p);
+        size_ = (size_t)st.st_size;
+        return true;
+    }
+
+    void MappedFile::close() {
+        if (data_) munmap(const_cast<std::uint8_t*>(data_), size_);
+        data_ = nullptr; size_ = 0;
+    }
+#endif
+
+} // namespace transport
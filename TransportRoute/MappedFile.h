@@ -0,0 +1,32 @@
+#pragma once
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+namespace transport {
+
+    // Archivo mapeado en memoria de solo lectura (mmap / MapViewOfFile).
+    // No copiable: compartir con shared_ptr.
+    class MappedFile {
+    public:
+        MappedFile() = default;
+        ~MappedFile();
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        bool open(const std::string& path);
+        void close();
+
+        const std::uint8_t* data() const { return data_; }
+        size_t size() const { return size_; }
+
+    private:
+        const std::uint8_t* data_ = nullptr;
+        size_t size_ = 0;
+#ifdef _WIN32
+        void* file_ = nullptr;
+        void* mapping_ = nullptr;
+#endif
+    };
+
+} // namespace transport
@@ -0,0 +1 @@
+#include "NearestFacility.h"
@@ -0,0 +1,98 @@
+#pragma once
+#include <unordered_map>
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include "Result.h"
+#include "Graph.h"
+#include "CsrGraph.h"
+#include "GraphView.h"
+#include "SearchWorkspace.h"
+
+namespace transport {
+
+    // Dijkstra multi-fuente: todas las instalaciones (depositos, hospitales, ...) entran al heap
+    // con distancia 0 y una sola pasada deja, para cada estacion, la fuente mas cercana, la
+    // distancia y el padre. Es una particion tipo Voronoi de la red.
+    class NearestFacility {
+    public:
+        struct Partition {
+            std::vector<int> idOf;                   // slot -> vertexId
+            std::unordered_map<int, int> idxOf;      // vertexId -> slot
+            std::vector<int> nearest;                // slot -> id de la fuente mas cercana (-1 = ninguna)
+            std::vector<double> dist;                // slot -> distancia a esa fuente
+            std::vector<int> parent;                 // slot -> slot previo hacia la fuente (-1 en fuentes)
+
+            int sourceOf(int id) const {
+                auto it = idxOf.find(id);
+                return it == idxOf.end() ? -1 : nearest[it->second];
+            }
+            double distanceTo(int id) const {
+                auto it = idxOf.find(id);
+                return it == idxOf.end() ? std::numeric_limits<double>::infinity() : dist[it->second];
+            }
+
+            // camino desde la fuente mas cercana hasta 'id'
+            PathResult path(int id) const {
+                PathResult res; res.algo = "NearestFacility";
+                auto it = idxOf.find(id);
+                if (it == idxOf.end() || nearest[it->second] == -1) return res;
+                res.reachable = true;
+                res.cost = dist[it->second];
+                for (int cur = it->second; cur != -1; cur = parent[cur]) res.path.push_back(idOf[cur]);
+                std::reverse(res.path.begin(), res.path.end());
+                return res;
+            }
+
+            // estaciones atendidas por cada fuente (zonificacion)
+            std::unordered_map<int, std::vector<int>> cells() const {
+                std::unordered_map<int, std::vector<int>> out;
+                for (size_t s = 0; s < nearest.size(); ++s) if (nearest[s] != -1) out[nearest[s]].push_back(idOf[s]);
+                return out;
+            }
+        };
+
+        static Partition compute(const Graph& g, const std::vector<int>& sources) { SearchWorkspace ws; return computeIndexed(g, sources, ws); }
+        static Partition compute(const CsrGraph& g, const std::vector<int>& sources) { SearchWorkspace ws; return computeIndexed(g, sources, ws); }
+        static Partition compute(const Graph& g, const std::vector<int>& sources, SearchWorkspace& ws) { return computeIndexed(g, sources, ws); }
+        static Partition compute(const CsrGraph& g, const std::vector<int>& sources, SearchWorkspace& ws) { return computeIndexed(g, sources, ws); }
+
+    private:
+        template <typename G>
+        static Partition computeIndexed(const G& g, const std::vector<int>& sources, SearchWorkspace& ws) {
+            int n = g.vertexCount();
+            Partition p;
+            p.idOf.resize(n);
+            p.idxOf.reserve(n);
+            for (int i = 0; i < n; ++i) { p.idOf[i] = g.idAt(i); p.idxOf[p.idOf[i]] = i; }
+            p.nearest.assign(n, -1);
+            p.dist.assign(n, std::numeric_limits<double>::infinity());
+            p.parent.assign(n, -1);
+
+            ws.reset(n);
+            for (int id : sources) {
+                int s = g.indexOf(id);
+                if (s < 0 || ws.reached(s)) continue; // inexistente o repetida
+                ws.set(s, 0.0, -1);
+                ws.heap.pushOrDecrease(s, 0.0);
+                p.nearest[s] = id;
+            }
+            while (!ws.heap.empty()) {
+                auto [du, u] = ws.heap.pop();
+                ws.settle(u);
+                p.dist[u] = du;
+                p.parent[u] = ws.parent(u);
+                forEachOpenNeighborAt(g, u, [&](int v, double w) {
+                    double nd = du + w;
+                    if (!ws.settled(v) && nd < ws.dist(v)) {
+                        ws.set(v, nd, u);
+                        ws.heap.pushOrDecrease(v, nd);
+                        p.nearest[v] = p.nearest[u]; // hereda la fuente del padre
+                    }
+                    });
+            }
+            return p;
+        }
+    };
+
+} // namespace transport
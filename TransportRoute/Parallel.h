@@ -0,0 +1,59 @@
+#pragma once
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <algorithm>
+
+namespace transport {
+
+    // Hilos a usar: threads <= 0 -> hardware_concurrency (minimo 1)
+    inline int workerCount(int threads = 0) {
+        if (threads > 0) return threads;
+        unsigned hc = std::thread::hardware_concurrency();
+        return hc == 0 ? 1 : (int)hc;
+    }
+
+    // Ejecuta fn(i, worker) para i en [begin, end) repartiendo dinamicamente entre hilos.
+    // 'worker' (0..hilos-1) sirve para indexar estado por hilo (workspaces, buffers).
+    // fn no debe lanzar excepciones.
+    template <typename Fn>
+    inline void parallelFor(int begin, int end, Fn fn, int threads = 0) {
+        if (end <= begin) return;
+        int workers = std::min(workerCount(threads), end - begin);
+        if (workers <= 1) {
+            for (int i = begin; i < end; ++i) fn(i, 0);
+            return;
+        }
+        std::atomic<int> nextIdx{ begin };
+        auto body = [&](int w) {
+            for (int i = nextIdx.fetch_add(1); i < end; i = nextIdx.fetch_add(1)) fn(i, w);
+            };
+        std::vector<std::thread> pool;
+        pool.reserve(workers - 1);
+        for (int w = 1; w < workers; ++w) pool.emplace_back(body, w);
+        body(0);
+        for (auto& t : pool) t.join();
+    }
+
+    // std::sort por bloques en paralelo y mezcla por pares (tambien en paralelo) hasta un solo
+    // bloque. Debajo de MinParallelSort elementos no vale la pena lanzar hilos.
+    template <typename It, typename Cmp>
+    inline void parallelSort(It first, It last, Cmp cmp, int threads = 0) {
+        constexpr long long MinParallelSort = 1 << 15;
+        long long n = last - first;
+        int workers = workerCount(threads);
+        if (workers <= 1 || n < MinParallelSort) { std::sort(first, last, cmp); return; }
+        int blocks = (int)std::min<long long>(workers, n / (MinParallelSort / 2));
+        std::vector<long long> cut(blocks + 1);
+        for (int b = 0; b <= blocks; ++b) cut[b] = n * b / blocks;
+        parallelFor(0, blocks, [&](int b, int) { std::sort(first + cut[b], first + cut[b + 1], cmp); }, workers);
+        for (int step = 1; step < blocks; step *= 2) {
+            int pairs = (blocks + 2 * step - 1) / (2 * step);
+            parallelFor(0, pairs, [&](int p, int) {
+                int lo = p * 2 * step, mid = lo + step, hi = std::min(blocks, lo + 2 * step);
+                if (mid < hi) std::inplace_merge(first + cut[lo], first + cut[mid], first + cut[hi], cmp);
+                }, workers);
+        }
+    }
+
+} // namespace transport
@@ -1,41 +1,49 @@
 #pragma once
-#include <queue>
-#include <unordered_set>
+#include <vector>
 #include "Result.h"
 #include "GraphView.h"
+#include "SearchWorkspace.h"
 
 namespace transport {
 
     class Prim {
-    public:
-        // arranca desde 'start'; si el grafo es desconectado, genera MST del componente
-        static MSTResult mst(const Graph& g, int start) {
+        // dist(v) = peso minimo conocido para conectar v al arbol, parent(v) = extremo en el arbol
+        template <typename G>
+        static MSTResult mstIndexed(const G& g, int startId, SearchWorkspace& ws) {
             MSTResult res; res.algo = "Prim";
-            if (!g.hasVertex(start)) return res;
+            int start = g.indexOf(startId);
+            if (start < 0) return res;
 
-            struct Item { double w; int u; int v; bool operator<(const Item& o) const { return w > o.w; } };
-            std::priority_queue<Item> pq;
-            std::unordered_set<int> in;
+            ws.reset(g.vertexCount());
+            auto& pq = ws.heap; // clave = peso minimo para conectar v
 
             auto pushEdges = [&](int u) {
-                forEachOpenNeighbor(g, u, [&](int v, double w) {
-                    if (!in.count(v)) pq.push({ w,u,v });
+                forEachOpenNeighborAt(g, u, [&](int v, double w) {
+                    if (!ws.settled(v) && w < ws.dist(v)) {
+                        ws.set(v, w, u);
+                        pq.pushOrDecrease(v, w);
+                    }
                     });
                 };
 
-            in.insert(start);
+            ws.settle(start);
             pushEdges(start);
 
             while (!pq.empty()) {
-                auto [w, u, v] = pq.top(); pq.pop();
-                if (in.count(v)) continue;
-                in.insert(v);
-                res.edges.emplace_back(u, v);
+                auto [w, v] = pq.pop();
+                ws.settle(v);
+                res.edges.emplace_back(g.idAt(ws.parent(v)), g.idAt(v));
                 res.totalWeight += w;
                 pushEdges(v);
             }
             return res;
         }
+    public:
+        // arranca desde 'start'; si el grafo es desconectado, genera MST del componente
+        static MSTResult mst(const Graph& g, int start) { SearchWorkspace ws; return mstIndexed(g, start, ws); }
+        static MSTResult mst(const CsrGraph& g, int start) { SearchWorkspace ws; return mstIndexed(g, start, ws); }
+        static MSTResult mst(const Graph& g, int start, SearchWorkspace& ws) { return mstIndexed(g, start, ws); }
+        static MSTResult mst(const CsrGraph& g, int start, SearchWorkspace& ws) { return mstIndexed(g, start, ws); }
     };
 
 } // namespace transport
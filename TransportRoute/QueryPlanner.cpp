@@ -0,0 +1 @@
+#include "QueryPlanner.h"
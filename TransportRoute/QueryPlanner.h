@@ -0,0 +1,175 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <sstream>
+#include <algorithm>
+
+namespace transport {
+
+    enum class QueryPattern { SinglePair, OneToMany, AllPairs };
+
+    enum class Engine { None, Dijkstra, BidirectionalDijkstra, ALT, CH, CRP, HubLabels, AllPairsMatrix, LazyRows };
+
+    // Planificador por costo: estima el tiempo de preparar y consultar cada motor para las
+    // consultas que se esperan, sumando lo que cuesta rehacer su indice con la tasa de cambios
+    // (cierres/accidentes) observada, y elige el menor que entra en memoria. Donde el llamador ya
+    // midio un motor (Timings) usa esa medicion; el modelo solo cubre lo que todavia no se corrio.
+    class QueryPlanner {
+    public:
+        // tiempos medidos por el llamador: promedio movil en ms por motor y fase
+        class Timings {
+        public:
+            enum Phase { Build, Rebuild, Query }; // Rebuild: poner al dia un indice existente
+
+            void record(Engine e, Phase ph, double ms) {
+                Slot& s = slots_[(int)e][ph];
+                s.ms = s.samples == 0 ? ms : 0.7 * s.ms + 0.3 * ms;
+                ++s.samples;
+            }
+            bool measured(Engine e, Phase ph) const { return slots_[(int)e][ph].samples > 0; }
+            double ms(Engine e, Phase ph) const { return slots_[(int)e][ph].ms; }
+
+        private:
+            struct Slot { double ms = 0.0; int samples = 0; };
+            Slot slots_[(int)Engine::LazyRows + 1][3];
+        };
+
+        // modelo sin mediciones, en barridos (un Dijkstra completo, (N + M) log N). Calibrado en
+        // grillas de 3600 y 90000 vertices, pesos 1-10, un hilo: un barrido ~1.5 ns por unidad
+        static constexpr double DefaultNsPerUnit = 1.5;
+
+        struct Input {
+            int vertices = 0;
+            int edges = 0;                          // aristas no dirigidas (con paralelas)
+            QueryPattern pattern = QueryPattern::SinglePair;
+            int expectedQueries = 1;                // consultas previstas hasta el proximo cambio
+            double churn = 0.0;                     // cambios del grafo por consulta (0..1)
+            // indices ya listos para el grafo actual
+            bool matrixWarm = false;
+            bool hubLabelsWarm = false;
+            bool chWarm = false;
+            bool crpWarm = false;
+            bool altWarm = false;
+            bool lazyRowWarm = false;               // arbol del origen ya en la LRU
+            size_t memoryBudgetBytes = size_t(512) << 20;
+            bool matrixAllowed = true;              // false: NxN prohibido por otra regla del llamador
+            const Timings* measured = nullptr;      // tiempos observados (null: solo el modelo)
+        };
+
+        struct Plan {
+            Engine engine = Engine::None;
+            double estimatedCost = 0.0;             // tiempo total estimado (ms)
+            size_t estimatedBytes = 0;
+            bool refused = false;                   // se pidio NxN y no entra en el presupuesto
+            std::string reason;                     // texto para PathResult::plan y el log
+        };
+
+        static const char* name(Engine e) {
+            switch (e) {
+            case Engine::Dijkstra: return "Dijkstra";
+            case Engine::BidirectionalDijkstra: return "BidirectionalDijkstra";
+            case Engine::ALT: return "ALT";
+            case Engine::CH: return "CH";
+            case Engine::CRP: return "CRP";
+            case Engine::HubLabels: return "HubLabels";
+            case Engine::AllPairsMatrix: return "AllPairsMatrix";
+            case Engine::LazyRows: return "LazyAllPairs";
+            default: return "None";
+            }
+        }
+
+        // dist (double) + next (int) por par
+        static size_t matrixBytes(int n) { return (size_t)n * (size_t)n * (sizeof(double) + sizeof(int)); }
+
+        static Plan plan(const Input& in) {
+            const double n = std::max(1, in.vertices), m = 2.0 * in.edges;
+            const double lg = std::log2(std::max(2.0, n));
+            const double sweep = (n + m) * lg;                       // un Dijkstra completo
+            const double q = std::max(1, in.expectedQueries);
+            const double churn = std::max(0.0, in.churn);
+            const double matrixBuild = std::min(n * n * n / 8.0, n * sweep); // Floyd vectorizado o N Dijkstra
+            const size_t matrixB = matrixBytes(in.vertices);
+
+            // ms por unidad del modelo: de las consultas Dijkstra medidas si las hay (su costo en
+            // barridos es el mas estable), si no el valor calibrado
+            double unitMs = DefaultNsPerUnit * 1e-6;
+            if (in.measured && in.measured->measured(Engine::BidirectionalDijkstra, Timings::Query))
+                unitMs = in.measured->ms(Engine::BidirectionalDijkstra, Timings::Query) / (0.3 * sweep);
+            else if (in.measured && in.measured->measured(Engine::Dijkstra, Timings::Query))
+                unitMs = in.measured->ms(Engine::Dijkstra, Timings::Query) / (0.5 * sweep);
+            auto ms = [&](Engine e, Timings::Phase ph, double units) {
+                return in.measured && in.measured->measured(e, ph) ? in.measured->ms(e, ph) : units * unitMs;
+                };
+
+            Plan p;
+            if (in.pattern == QueryPattern::AllPairs) {
+                p.estimatedBytes = matrixB;
+                if (matrixB > in.memoryBudgetBytes || !in.matrixAllowed) {
+                    p.refused = true;
+                    p.reason = "NxN rechazado: " + mb(matrixB) + (in.matrixAllowed ? " > presupuesto " + mb(in.memoryBudgetBytes) : " no permitido")
+                        + " (usar HubLabels o LazyAllPairs)";
+                    return p;
+                }
+                p.engine = Engine::AllPairsMatrix;
+                p.estimatedCost = in.matrixWarm ? 0.0 : ms(Engine::AllPairsMatrix, Timings::Build, matrixBuild);
+                p.reason = describe(p, in);
+                return p;
+            }
+
+            struct Option { Engine e; double build, query, rebuild; size_t bytes; bool warm; };
+            // en barridos medidos (ver DefaultNsPerUnit): ALT prepara ~35 y refresca ~10; CH ~1200
+            // (y se rehace entera si algo baja de costo); CRP particiona y customiza ~80 y absorbe
+            // un cambio en ~1; hub labels ~20 sqrt(N)
+            std::vector<Option> opts = {
+                { Engine::BidirectionalDijkstra, 0.0, 0.3 * sweep, 0.0, 0, true },
+                { Engine::ALT, 35.0 * sweep, 0.06 * sweep, 10.0 * sweep, (size_t)(16 * n * sizeof(double)), in.altWarm },
+                { Engine::CH, 1200.0 * sweep, 300.0 * lg * lg, 1200.0 * sweep, (size_t)(3 * (n + m) * 12), in.chWarm },
+                { Engine::CRP, 80.0 * sweep, 200.0 * std::sqrt(n) * lg, sweep, (size_t)(4 * (n + m) * 12), in.crpWarm },
+                { Engine::HubLabels, 20.0 * std::sqrt(n) * sweep, 15.0 * lg * lg, 20.0 * std::sqrt(n) * sweep,
+                  (size_t)(n * 8 * lg * 12), in.hubLabelsWarm },
+                { Engine::AllPairsMatrix, matrixBuild, std::sqrt(n), n * n, matrixB, in.matrixWarm },
+            };
+            if (in.pattern == QueryPattern::OneToMany) {
+                // un arbol por origen, repartido entre las consultas que lo reusan
+                opts.push_back({ Engine::LazyRows, sweep, std::sqrt(n), sweep, (size_t)(n * 12), in.lazyRowWarm });
+            }
+            else {
+                opts.push_back({ Engine::Dijkstra, 0.0, 0.5 * sweep, 0.0, 0, true });
+            }
+
+            double best = 0.0;
+            for (const auto& o : opts) {
+                if (o.bytes > in.memoryBudgetBytes) continue;
+                if (o.e == Engine::AllPairsMatrix && !in.matrixAllowed) continue;
+                double build = o.warm ? 0.0 : ms(o.e, Timings::Build, o.build);
+                double total = build + q * (ms(o.e, Timings::Query, o.query) + churn * ms(o.e, Timings::Rebuild, o.rebuild));
+                if (p.engine == Engine::None || total < best) {
+                    best = total;
+                    p.engine = o.e;
+                    p.estimatedCost = total;
+                    p.estimatedBytes = o.bytes;
+                }
+            }
+            p.reason = describe(p, in);
+            return p;
+        }
+
+    private:
+        static std::string mb(size_t bytes) {
+            std::ostringstream os; os << (bytes >> 20) << "MB";
+            return os.str();
+        }
+
+        static std::string describe(const Plan& p, const Input& in) {
+            static const char* patterns[] = { "par", "uno-a-muchos", "todos" };
+            std::ostringstream os;
+            os << name(p.engine) << " (N=" << in.vertices << " M=" << in.edges
+                << " patron=" << patterns[(int)in.pattern] << " Q=" << in.expectedQueries
+                << " churn=" << in.churn << " ms=" << p.estimatedCost << " mem=" << mb(p.estimatedBytes) << ")";
+            return os.str();
+        }
+    };
+
+} // namespace transport
@@ -10,6 +10,7 @@ namespace transport {
         double cost = std::numeric_limits<double>::infinity(); // suma de pesos
         bool reachable = false;
         std::string algo;        // nombre del algoritmo (debug/log)
+        std::string plan;        // motor elegido por el planificador y por que (vacio si no se planifico)
     };
 
     struct VisitResult {
@@ -23,8 +23,9 @@ namespace transport {
         std::ofstream out(path, std::ios::trunc);
         if (!out) return false;
         out << "# u v peso\n";
-        for (const auto& [u, vec] : g.data()) {
-            for (const auto& e : vec) {
+        for (int s = 0; s < g.vertexCount(); ++s) {
+            int u = g.idAt(s);
+            for (const auto& e : g.neighborsAt(s)) {
                 out << u << " " << e.to << " " << e.w << "\n";
             }
         }
@@ -0,0 +1 @@
+#include "SearchWorkspace.h"
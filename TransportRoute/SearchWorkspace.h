@@ -0,0 +1,64 @@
+#pragma once
+#include <vector>
+#include <limits>
+#include <cstdint>
+#include <utility>
+#include <algorithm>
+#include "IndexedHeap.h"
+
+namespace transport {
+
+    // Estado por vertice reutilizable entre consultas (dist/parent/visitado + cola/heap).
+    // Cada reset() abre una generacion nueva: una entrada solo vale si su sello == gen_,
+    // asi limpiar cuesta O(1) y solo se tocan los vertices alcanzados.
+    // No es thread-safe: un workspace por hilo (ver forThisThread()).
+    class SearchWorkspace {
+        std::vector<double> dist_;
+        std::vector<int> parent_;
+        std::vector<std::uint32_t> reached_;  // sello: dist_/parent_ validos
+        std::vector<std::uint32_t> settled_;  // sello: vertice cerrado/visitado
+        std::uint32_t gen_ = 0;
+
+    public:
+        // almacenamiento reutilizable para los algoritmos
+        std::vector<int> queue;                        // cola BFS / pila
+        IndexedDaryHeap<4> heap;                       // Dijkstra/Prim con decrease-key
+        RadixHeap radix;                               // Dijkstra con HeapKind::Radix
+
+        // prepara una busqueda sobre n vertices
+        void reset(int n) {
+            if ((int)dist_.size() < n) {
+                dist_.resize(n);
+                parent_.resize(n);
+                reached_.resize(n, 0);
+                settled_.resize(n, 0);
+            }
+            if (++gen_ == 0) { // desborde del contador: limpieza completa (rara vez)
+                std::fill(reached_.begin(), reached_.end(), 0);
+                std::fill(settled_.begin(), settled_.end(), 0);
+                gen_ = 1;
+            }
+            queue.clear();
+            heap.clear();
+            heap.reserve(n);
+            radix.clear();
+        }
+
+        int capacity() const { return (int)dist_.size(); }
+
+        bool reached(int v) const { return reached_[v] == gen_; }
+        double dist(int v) const { return reached(v) ? dist_[v] : std::numeric_limits<double>::infinity(); }
+        int parent(int v) const { return reached(v) ? parent_[v] : -1; }
+        void set(int v, double d, int p) { reached_[v] = gen_; dist_[v] = d; parent_[v] = p; }
+
+        bool settled(int v) const { return settled_[v] == gen_; }
+        void settle(int v) { settled_[v] = gen_; }
+
+        // workspace propio del hilo que llama
+        static SearchWorkspace& forThisThread() {
+            thread_local SearchWorkspace ws;
+            return ws;
+        }
+    };
+
+} // namespace transport
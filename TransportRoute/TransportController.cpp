@@ -25,6 +25,10 @@ namespace transport {
         return os.str();
     }
 
+    static double elapsedMs(std::chrono::steady_clock::time_point t0) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    }
+
     TransportController::TransportController()
         : stations([](const Station& s) { return s.id; }) {
     }
@@ -45,18 +49,21 @@ namespace transport {
         }
         // aplicar cierres (si el archivo existe)
         reloadClosures();
+        // verificar la heuristica de A* contra los pesos cargados
+        geoHeuristic.reset();
+        ensureHeuristic();
 
         // log simple
         auto ordered = stationsInOrder();
         ReportsFile::appendStationsInOrder(reportesPath, ordered);
         logLine("[" + nowStamp() + "] LoadAll: estaciones=" + std::to_string(ordered.size())
-            + " verticesGraficados=" + std::to_string((int)graph.data().size()));
+            + " verticesGraficados=" + std::to_string(graph.vertexCount()));
         return true;
     }
 
     bool TransportController::reloadClosures() {
         bool ok = ClosuresFile::applyClosures(cierresPath, graph);
-        if (ok) invalidateAllPairs();
+        // Floyd se actualiza de forma incremental en ensureAllPairs
         logLine("[" + nowStamp() + "] ReloadClosures: applied=" + std::string(ok ? "true" : "false"));
         return ok;
     }
@@ -79,7 +86,8 @@ namespace transport {
 
     bool TransportController::reloadAccidents() {
         bool ok = AccidentsFile::apply(accidentesPath, graph);
-        if (ok) invalidateAllPairs(); // cambian costos -> recomputar Floyd
+        // cambian costos: Floyd se actualiza (solo filas afectadas) en ensureAllPairs
+        if (ok && crpMetric.ready) ensureCRP(); // absorber el lote ya (solo celdas tocadas)
         logLine("[" + nowStamp() + "] ReloadAccidents: applied=" + std::string(ok ? "true" : "false"));
         return ok;
     }
@@ -106,8 +114,9 @@ namespace transport {
     bool TransportController::exportGraphSummary() {
         // conexiones
         logLine("=== GRAPH SUMMARY ===");
-        for (const auto& [u, vec] : graph.data()) {
-            for (const auto& e : vec) {
+        for (int s = 0; s < graph.vertexCount(); ++s) {
+            int u = graph.idAt(s);
+            for (const auto& e : graph.neighborsAt(s)) {
                 if (u < e.to) { // una vez
                     std::ostringstream os;
                     os << "Edge " << u << " - " << e.to
@@ -138,7 +147,6 @@ namespace transport {
 
     bool TransportController::setClosed(int u, int v, bool c) {
         bool ok = graph.setClosed(u, v, c);
-        invalidateAllPairs();
         // opcional: persistir esto en cierres.txt (sobrescribir)
         return ok;
     }
@@ -150,15 +158,24 @@ namespace transport {
     }
 
     VisitResult TransportController::runBFS(int start) {
-        auto r = AlgoFacade::runBFS(graph, start);
+        auto r = AlgoFacade::runBFS(snapshot(), start, workspace);
         std::ostringstream os; os << "[" << nowStamp() << "] BFS start=" << start << " order=";
         for (size_t i = 0; i < r.order.size(); ++i) { if (i) os << ","; os << r.order[i]; }
         logLine(os.str());
         return r;
     }
 
+    BFS::Levels TransportController::runBFSLevels(int start) {
+        auto r = AlgoFacade::runBFSLevels(snapshot(), start);
+        std::ostringstream os; os << "[" << nowStamp() << "] BFSLevels start=" << start
+            << " alcanzados=" << r.order.size() << " porNivel=";
+        for (int l = 0; l < r.depth(); ++l) { if (l) os << ","; os << r.levelStart[l + 1] - r.levelStart[l]; }
+        logLine(os.str());
+        return r;
+    }
+
     VisitResult TransportController::runDFS(int start) {
-        auto r = AlgoFacade::runDFS(graph, start);
+        auto r = AlgoFacade::runDFS(snapshot(), start);
         std::ostringstream os; os << "[" << nowStamp() << "] DFS start=" << start << " order=";
         for (size_t i = 0; i < r.order.size(); ++i) { if (i) os << ","; os << r.order[i]; }
         logLine(os.str());
@@ -166,7 +183,9 @@ namespace transport {
     }
 
     PathResult TransportController::runDijkstra(int src, int dst) {
-        auto r = AlgoFacade::runDijkstra(graph, src, dst);
+        // par en componentes distintas: responder sin recorrer la componente de src
+        PathResult r; r.algo = "Connectivity";
+        if (AlgoFacade::connected(graph, src, dst)) r = AlgoFacade::runBidirectionalDijkstra(snapshot(), src, dst, workspace, workspaceBack);
         auto list = stationsOnPath(r.path);
         std::ostringstream os2; os2 << "Ruta (" << r.algo << "): ";
         for (size_t i = 0; i < list.size(); ++i) { if (i) os2 << " -> "; os2 << list[i].id << " " << list[i].name; }
@@ -179,9 +198,80 @@ namespace transport {
         return r;
     }
 
+    PathResult TransportController::runAStar(int src, int dst) {
+        ensureHeuristic();
+        auto r = AlgoFacade::runAStar(snapshot(), src, dst, *geoHeuristic, workspace);
+        auto list = stationsOnPath(r.path);
+        std::ostringstream os2; os2 << "Ruta (" << r.algo << "): ";
+        for (size_t i = 0; i < list.size(); ++i) { if (i) os2 << " -> "; os2 << list[i].id << " " << list[i].name; }
+        logLine(os2.str()); // queda en reportes.txt
+        std::ostringstream os; os << "[" << nowStamp() << "] AStar " << src << "->" << dst
+            << " reachable=" << (r.reachable ? "1" : "0")
+            << " cost=" << r.cost << " path=";
+        for (size_t i = 0; i < r.path.size(); ++i) { if (i) os << "-"; os << r.path[i]; }
+        logLine(os.str());
+        return r;
+    }
+
+    PathResult TransportController::runALT(int src, int dst) {
+        ensureAlt();
+        auto r = AlgoFacade::runALT(graph, *altIndex, src, dst, workspace);
+        auto list = stationsOnPath(r.path);
+        std::ostringstream os2; os2 << "Ruta (" << r.algo << "): ";
+        for (size_t i = 0; i < list.size(); ++i) { if (i) os2 << " -> "; os2 << list[i].id << " " << list[i].name; }
+        logLine(os2.str()); // queda en reportes.txt
+        std::ostringstream os; os << "[" << nowStamp() << "] ALT " << src << "->" << dst
+            << " reachable=" << (r.reachable ? "1" : "0")
+            << " cost=" << r.cost << " path=";
+        for (size_t i = 0; i < r.path.size(); ++i) { if (i) os << "-"; os << r.path[i]; }
+        logLine(os.str());
+        return r;
+    }
+
+    PathResult TransportController::runCH(int src, int dst) {
+        ensureCH();
+        auto r = AlgoFacade::runCH(graph, *chIndex, src, dst, workspace, workspaceBack);
+        auto list = stationsOnPath(r.path);
+        std::ostringstream os2; os2 << "Ruta (" << r.algo << "): ";
+        for (size_t i = 0; i < list.size(); ++i) { if (i) os2 << " -> "; os2 << list[i].id << " " << list[i].name; }
+        logLine(os2.str()); // queda en reportes.txt
+        std::ostringstream os; os << "[" << nowStamp() << "] CH " << src << "->" << dst
+            << " reachable=" << (r.reachable ? "1" : "0")
+            << " cost=" << r.cost << " path=";
+        for (size_t i = 0; i < r.path.size(); ++i) { if (i) os << "-"; os << r.path[i]; }
+        logLine(os.str());
+        return r;
+    }
+
+    PathResult TransportController::runCRP(int src, int dst) {
+        ensureCRP();
+        auto r = AlgoFacade::runCRP(graph, *crpPartition, crpMetric, src, dst, workspace, workspaceBack);
+        auto list = stationsOnPath(r.path);
+        std::ostringstream os2; os2 << "Ruta (" << r.algo << "): ";
+        for (size_t i = 0; i < list.size(); ++i) { if (i) os2 << " -> "; os2 << list[i].id << " " << list[i].name; }
+        logLine(os2.str()); // queda en reportes.txt
+        std::ostringstream os; os << "[" << nowStamp() << "] CRP " << src << "->" << dst
+            << " reachable=" << (r.reachable ? "1" : "0")
+            << " cost=" << r.cost << " path=";
+        for (size_t i = 0; i < r.path.size(); ++i) { if (i) os << "-"; os << r.path[i]; }
+        logLine(os.str());
+        return r;
+    }
+
     PathResult TransportController::runFloyd(int src, int dst) {
-        ensureAllPairs();
-        auto r = AlgoFacade::runFloyd(*floydCache, src, dst);
+        PathResult r;
+        if (!matrixFits() && allPairsLazyRows) {
+            ensureLazyAllPairs();
+            r = AlgoFacade::runLazyAllPairs(*lazyAllPairs, src, dst);
+        }
+        else if (!matrixFits()) {
+            ensureHubLabels();
+            r = AlgoFacade::runHubLabels(*hubLabels, src, dst);
+        }
+        else {
+            ensureAllPairs();
+            r = allPairsPath(src, dst);
+        }
         auto list = stationsOnPath(r.path);
         std::ostringstream os2; os2 << "Ruta (" << r.algo << "): ";
         for (size_t i = 0; i < list.size(); ++i) { if (i) os2 << " -> "; os2 << list[i].id << " " << list[i].name; }
@@ -194,8 +284,178 @@ namespace transport {
         return r;
     }
 
+    std::vector<PathResult> TransportController::runKShortest(int src, int dst, int k) {
+        auto rs = AlgoFacade::runKShortestPaths(snapshot(), src, dst, k, workspaceBack, workspace);
+        for (size_t a = 0; a < rs.size(); ++a) {
+            const auto& r = rs[a];
+            auto list = stationsOnPath(r.path);
+            std::ostringstream os2; os2 << "Ruta (" << r.algo << " #" << (a + 1) << "): ";
+            for (size_t i = 0; i < list.size(); ++i) { if (i) os2 << " -> "; os2 << list[i].id << " " << list[i].name; }
+            logLine(os2.str()); // queda en reportes.txt
+        }
+        std::ostringstream os; os << "[" << nowStamp() << "] KShortest " << src << "->" << dst
+            << " k=" << k << " encontrados=" << rs.size() << " costos=";
+        for (size_t i = 0; i < rs.size(); ++i) { if (i) os << ","; os << rs[i].cost; }
+        logLine(os.str());
+        return rs;
+    }
+
+    double TransportController::distance(int src, int dst) {
+        if (!matrixFits()) {
+            ensureHubLabels();
+            return hubLabels->distance(src, dst);
+        }
+        ensureAllPairs();
+        return allPairsPath(src, dst).cost;
+    }
+
+    DistanceTable::Table TransportController::distanceTable(const std::vector<int>& sources, const std::vector<int>& targets, bool withPaths) {
+        auto t0 = std::chrono::steady_clock::now();
+        auto t = AlgoFacade::runDistanceTable(snapshot(), sources, targets, withPaths);
+        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - t0).count();
+        size_t reached = 0;
+        for (double d : t.dist) if (d != std::numeric_limits<double>::infinity()) ++reached;
+        std::ostringstream os; os << "[" << nowStamp() << "] DistanceTable origenes=" << sources.size()
+            << " destinos=" << targets.size() << " alcanzados=" << reached << " ms=" << ms;
+        logLine(os.str()); // un resumen, no una linea por par
+        return t;
+    }
+
+    NearestFacility::Partition TransportController::nearestFacility(const std::vector<int>& sources) {
+        auto p = AlgoFacade::runNearestFacility(snapshot(), sources, workspace);
+        auto cells = p.cells();
+        std::vector<int> ids;
+        for (const auto& c : cells) ids.push_back(c.first);
+        std::sort(ids.begin(), ids.end());
+        std::ostringstream os; os << "[" << nowStamp() << "] NearestFacility fuentes=" << sources.size() << " zonas=";
+        for (size_t i = 0; i < ids.size(); ++i) { if (i) os << ","; os << ids[i] << ":" << cells[ids[i]].size(); }
+        logLine(os.str());
+        return p;
+    }
+
+    Isochrone::Reach TransportController::isochrone(int origin, double maxCost, int maxHops) {
+        Isochrone::Limits lim; lim.maxCost = maxCost; lim.maxHops = maxHops;
+        // sobre Graph directamente: armar la foto CSR costaria O(red) y la consulta es O(resultado)
+        auto r = AlgoFacade::runIsochrone(graph, origin, lim, workspace);
+        std::ostringstream os; os << "[" << nowStamp() << "] Isochrone origen=" << origin
+            << " costo<=" << maxCost << " saltos<=" << maxHops << " estaciones=" << r.size();
+        logLine(os.str());
+        return r;
+    }
+
+    std::vector<Isochrone::Reach> TransportController::isochrones(const std::vector<int>& origins, double maxCost, int maxHops) {
+        Isochrone::Limits lim; lim.maxCost = maxCost; lim.maxHops = maxHops;
+        auto out = AlgoFacade::runIsochrones(graph, origins, lim);
+        size_t total = 0;
+        for (const auto& r : out) total += r.size();
+        std::ostringstream os; os << "[" << nowStamp() << "] Isochrones origenes=" << origins.size()
+            << " costo<=" << maxCost << " saltos<=" << maxHops << " estaciones=" << total;
+        logLine(os.str());
+        return out;
+    }
+
+    const Biconnectivity::Report& TransportController::networkCuts() {
+        if (cutsCache.has_value() && cutsCache->validFor(graph)) return *cutsCache;
+        cutsCache = AlgoFacade::analyzeCuts(snapshot());
+        std::ostringstream os; os << "[" << nowStamp() << "] Biconnectivity: puentes=" << cutsCache->closureBridges.size()
+            << " articulaciones=" << cutsCache->articulation.size() << " componentes=" << cutsCache->components.size();
+        logLine(os.str());
+        return *cutsCache;
+    }
+
+    bool TransportController::closureSplitsNetwork(int u, int v) {
+        return networkCuts().closureSplits(u, v);
+    }
+
+    QueryPlanner::Plan TransportController::planQuery(QueryPattern pattern, int src) {
+        const CsrGraph& c = snapshot();
+        // uso observado contando esta consulta, sin registrarla (eso lo hace notePlanQuery)
+        bool changed = planSawChange();
+
+        QueryPlanner::Input in;
+        in.vertices = c.vertexCount();
+        in.edges = c.edgeSlots() / 2;
+        in.pattern = pattern;
+        in.expectedQueries = changed ? 1 : planSinceChange + 1; // se esperan tantas como las vistas sin cambios
+        in.churn = 0.9 * planChurn + 0.1 * (changed ? 1.0 : 0.0);
+        in.matrixWarm = (floydCache.has_value() || floydCompact.has_value()) && matrixFits(); // se actualiza por diferencias
+        in.hubLabelsWarm = hubLabels.has_value() && hubLabels->validFor(graph);
+        in.chWarm = chIndex.has_value() && chIndex->validFor(graph);
+        in.crpWarm = crpMetric.validFor(graph);
+        in.altWarm = altIndex.has_value() && altIndex->validFor(graph);
+        in.lazyRowWarm = lazyAllPairs.has_value() && lazyAllPairs->cached(src);
+        in.memoryBudgetBytes = memoryBudgetBytes;
+        in.matrixAllowed = in.vertices <= allPairsMaxVertices;
+        in.measured = &planTimings;
+        return AlgoFacade::plan(in);
+    }
+
+    void TransportController::notePlanQuery(int src) {
+        bool changed = planSawChange();
+        planChurn = 0.9 * planChurn + 0.1 * (changed ? 1.0 : 0.0);
+        planVersion = graph.version();
+        ++planQueries;
+        planSinceChange = changed ? 1 : planSinceChange + 1;
+        planLastSource = src;
+    }
+
+    PathResult TransportController::route(int src, int dst) {
+        // mismo origen que la consulta anterior: patron uno-a-muchos
+        auto pattern = src == planLastSource ? QueryPattern::OneToMany : QueryPattern::SinglePair;
+        auto plan = planQuery(pattern, src);
+        notePlanQuery(src);
+        PathResult r; r.algo = "Connectivity";
+        if (!AlgoFacade::connected(graph, src, dst)) plan.reason = "Connectivity (componentes distintas, sin busqueda)";
+        else {
+            switch (plan.engine) { // preparar: cada ensure mide su propia construccion
+            case Engine::AllPairsMatrix: ensureAllPairs(); break;
+            case Engine::LazyRows: ensureLazyAllPairs(); break;
+            case Engine::HubLabels: ensureHubLabels(); break;
+            case Engine::CH: ensureCH(); break;
+            case Engine::CRP: ensureCRP(); break;
+            case Engine::ALT: ensureAlt(); break;
+            default: snapshot(); break;
+            }
+            // una fila nueva de LazyAllPairs es un arbol completo: cuenta como construccion
+            auto phase = plan.engine == Engine::LazyRows && !lazyAllPairs->cached(src) ? QueryPlanner::Timings::Build : QueryPlanner::Timings::Query;
+            auto t0 = std::chrono::steady_clock::now();
+            switch (plan.engine) {
+            case Engine::AllPairsMatrix: r = allPairsPath(src, dst); break;
+            case Engine::LazyRows: r = AlgoFacade::runLazyAllPairs(*lazyAllPairs, src, dst); break;
+            case Engine::HubLabels: r = AlgoFacade::runHubLabels(*hubLabels, src, dst); break;
+            case Engine::CH: r = AlgoFacade::runCH(graph, *chIndex, src, dst, workspace, workspaceBack); break;
+            case Engine::CRP: r = AlgoFacade::runCRP(graph, *crpPartition, crpMetric, src, dst, workspace, workspaceBack); break;
+            case Engine::ALT: r = AlgoFacade::runALT(graph, *altIndex, src, dst, workspace); break;
+            case Engine::Dijkstra: r = AlgoFacade::runDijkstra(snapshot(), src, dst, workspace); break;
+            default: r = AlgoFacade::runBidirectionalDijkstra(snapshot(), src, dst, workspace, workspaceBack); break;
+            }
+            planTimings.record(plan.engine, phase, elapsedMs(t0));
+        }
+        r.plan = plan.reason;
+        auto list = stationsOnPath(r.path);
+        std::ostringstream os2; os2 << "Ruta (" << r.algo << "): ";
+        for (size_t i = 0; i < list.size(); ++i) { if (i) os2 << " -> "; os2 << list[i].id << " " << list[i].name; }
+        logLine(os2.str()); // queda en reportes.txt
+        std::ostringstream os; os << "[" << nowStamp() << "] Route " << src << "->" << dst
+            << " plan=" << r.plan
+            << " reachable=" << (r.reachable ? "1" : "0")
+            << " cost=" << r.cost << " path=";
+        for (size_t i = 0; i < r.path.size(); ++i) { if (i) os << "-"; os << r.path[i]; }
+        logLine(os.str());
+        return r;
+    }
+
+    bool TransportController::precomputeAllPairs() {
+        auto plan = planQuery(QueryPattern::AllPairs);
+        notePlanQuery(-1);
+        logLine("[" + nowStamp() + "] Plan todos-los-pares: " + plan.reason);
+        if (plan.refused) return false;
+        ensureAllPairs();
+        return true;
+    }
+
     MSTResult TransportController::runPrim(int start) {
-        auto r = AlgoFacade::runPrim(graph, start);
+        auto r = AlgoFacade::runPrim(snapshot(), start, workspace);
         std::ostringstream os; os << "[" << nowStamp() << "] Prim start=" << start
             << " edges=" << r.edges.size()
             << " total=" << r.totalWeight;
@@ -204,7 +464,7 @@ namespace transport {
     }
 
     MSTResult TransportController::runKruskal() {
-        auto r = AlgoFacade::runKruskal(graph);
+        auto r = AlgoFacade::runKruskal(snapshot());
         std::ostringstream os; os << "[" << nowStamp() << "] Kruskal edges=" << r.edges.size()
             << " total=" << r.totalWeight;
         logLine(os.str());
@@ -226,12 +486,163 @@ namespace transport {
 
     void TransportController::invalidateAllPairs() {
         floydCache.reset();
+        floydCompact.reset();
+        floydBase.reset();
+        hubLabels.reset();
+    }
+
+    void TransportController::ensureHubLabels() {
+        if (hubLabels.has_value() && hubLabels->validFor(graph)) return;
+        auto t0 = std::chrono::steady_clock::now();
+        hubLabels = AlgoFacade::computeHubLabels(graph);
+        double ms = elapsedMs(t0); // siempre desde cero: vale para construir y para rehacer
+        planTimings.record(Engine::HubLabels, QueryPlanner::Timings::Build, ms);
+        planTimings.record(Engine::HubLabels, QueryPlanner::Timings::Rebuild, ms);
+        logLine("[" + nowStamp() + "] HubLabels: etiquetas=" + std::to_string(hubLabels->labelEntries())
+            + " bytes=" + std::to_string(hubLabels->bytes()));
+    }
+
+    bool TransportController::matrixFits() const {
+        int n = graph.vertexCount();
+        return n <= allPairsMaxVertices && QueryPlanner::matrixBytes(n) <= memoryBudgetBytes;
+    }
+
+    void TransportController::ensureLazyAllPairs() {
+        // las filas se descartan solas cuando cambia graph.version()
+        if (!lazyAllPairs.has_value()) lazyAllPairs.emplace(graph, allPairsRowBudgetBytes);
+        else if (lazyAllPairs->budget() != allPairsRowBudgetBytes) lazyAllPairs->setBudget(allPairsRowBudgetBytes);
+    }
+
+    const CsrGraph& TransportController::snapshot() {
+        if (!csrCache.has_value() || csrCache->sourceVersion != graph.version()) {
+            csrCache = AlgoFacade::snapshot(graph);
+        }
+        return *csrCache;
     }
 
     void TransportController::ensureAllPairs() {
-        if (!floydCache.has_value()) {
-            floydCache = AlgoFacade::computeFloyd(graph);
+        auto t0 = std::chrono::steady_clock::now();
+        bool stale = floydBase.has_value() && floydBase->sourceVersion != graph.version();
+        if (stale && floydCompact.has_value()) {
+            // la forma compacta no se actualiza: volver a la matriz exacta de la foto anterior
+            floydCache = floydCompact->expand(*floydBase);
+            floydCompact.reset();
+        }
+        if (stale && floydCache.has_value()) {
+            // el grafo cambio desde el calculo: actualizar en lugar de tirar la matriz
+            auto st = FloydWarshall::update(*floydCache, *floydBase, graph);
+            if (st.full) floydCache.reset();
+            else {
+                floydBase = snapshot();
+                planTimings.record(Engine::AllPairsMatrix, QueryPlanner::Timings::Rebuild, elapsedMs(t0));
+                std::ostringstream os; os << "[" << nowStamp() << "] Floyd: actualizacion incremental bajas=" << st.decreased
+                    << " subidas=" << st.increased << " filas=" << st.rowsRecomputed;
+                logLine(os.str());
+            }
+        }
+        if (!floydCache.has_value() && !floydCompact.has_value()) {
+            floydBase = snapshot();
+            // mismo grafo (rutas + cierres + accidentes) -> reusar lo calculado en otra sesion
+            std::uint64_t hash = allPairsCachePath.empty() ? 0 : CompactAllPairs::graphHash(graph);
+            auto disk = allPairsCachePath.empty() ? std::nullopt : CompactAllPairs::open(allPairsCachePath);
+            if (disk && disk->hash() == hash && disk->size() == graph.vertexCount()) {
+                if (allPairsCompactInMemory) floydCompact = std::move(disk);
+                else floydCache = disk->expand(graph);
+                planTimings.record(Engine::AllPairsMatrix, QueryPlanner::Timings::Build, elapsedMs(t0));
+                logLine("[" + nowStamp() + "] Floyd: cache en disco reutilizado (" + allPairsCachePath + ")");
+                return;
+            }
+            disk.reset(); // soltar el mapeo antes de sobrescribir
+            computeAllPairs();
+            if (!floydCache.has_value()) return; // no entra en memoryBudgetBytes (los llamadores lo verifican antes)
+            if (!allPairsCachePath.empty()) {
+                floydCompact = CompactAllPairs::fromAllPairs(*floydCache, hash, allPairsCacheOptions);
+                bool saved = floydCompact->save(allPairsCachePath);
+                logLine("[" + nowStamp() + "] Floyd: cache en disco " + std::string(saved ? "guardado" : "no guardado")
+                    + " bytes=" + std::to_string(floydCompact->bytes()));
+            }
+        }
+        if (!allPairsCompactInMemory) { floydCompact.reset(); return; }
+        if (floydCache.has_value()) {
+            // quedarse solo con la forma compacta: float + next angosto en lugar de double + int
+            if (!floydCompact.has_value()) floydCompact = CompactAllPairs::fromAllPairs(*floydCache, 0, allPairsCacheOptions);
+            floydCache.reset();
+        }
+    }
+
+    PathResult TransportController::allPairsPath(int src, int dst) const {
+        if (floydCompact.has_value()) return AlgoFacade::runFloyd(*floydCompact, graph, src, dst);
+        if (floydCache.has_value()) return AlgoFacade::runFloyd(*floydCache, src, dst);
+        return PathResult{};
+    }
+
+    void TransportController::computeAllPairs() {
+        const CsrGraph& c = snapshot();
+        bool sparse = FloydWarshall::preferDijkstra(c);
+        auto t0 = std::chrono::steady_clock::now();
+        floydCache = AlgoFacade::computeAllPairs(c, memoryBudgetBytes);
+        double ms = elapsedMs(t0);
+        if (floydCache.has_value()) planTimings.record(Engine::AllPairsMatrix, QueryPlanner::Timings::Build, ms);
+        logLine("[" + nowStamp() + "] AllPairs: motor=" + std::string(sparse ? "Dijkstra" : "FloydWarshall")
+            + " n=" + std::to_string(c.vertexCount()) + " aristas=" + std::to_string(c.edgeSlots() / 2)
+            + (floydCache.has_value() ? " ms=" + std::to_string((long long)ms) : " rechazado (presupuesto)"));
+    }
+
+    void TransportController::ensureHeuristic() {
+        if (geoHeuristic.has_value() && geoHeuristic->checkedVersion == graph.version()) return;
+        // vertices nuevos necesitan coordenadas: reconstruir si cambio la cantidad
+        if (!geoHeuristic.has_value() || (int)geoHeuristic->x.size() != graph.vertexCount()) {
+            geoHeuristic = GeoHeuristic::build(graph, stationsInOrder(), astarCostPerDistance);
         }
+        else {
+            geoHeuristic->check(graph);
+        }
+        if (!geoHeuristic->valid) {
+            logLine("[" + nowStamp() + "] AStar: heuristica no consistente con los pesos, se usara Dijkstra");
+        }
+    }
+
+    void TransportController::ensureAlt() {
+        if (altIndex.has_value() && altIndex->validFor(graph)) return; // cierres/subidas: siguen siendo cotas
+        auto t0 = std::chrono::steady_clock::now();
+        if (altIndex.has_value() && altIndex->n == graph.vertexCount() && altIndex->k > 0) {
+            ALT::refresh(graph, *altIndex); // mismos landmarks, tablas nuevas
+            planTimings.record(Engine::ALT, QueryPlanner::Timings::Rebuild, elapsedMs(t0));
+        }
+        else {
+            altIndex = AlgoFacade::preprocessALT(graph, altLandmarkCount, altStrategy);
+            planTimings.record(Engine::ALT, QueryPlanner::Timings::Build, elapsedMs(t0));
+        }
+        logLine("[" + nowStamp() + "] ALT: tablas recalculadas landmarks=" + std::to_string(altIndex->k));
+    }
+
+    void TransportController::ensureCH() {
+        if (chIndex.has_value() && chIndex->validFor(graph)) return;
+        auto t0 = std::chrono::steady_clock::now();
+        chIndex = AlgoFacade::preprocessCH(graph);
+        double ms = elapsedMs(t0); // siempre desde cero: vale para construir y para rehacer
+        planTimings.record(Engine::CH, QueryPlanner::Timings::Build, ms);
+        planTimings.record(Engine::CH, QueryPlanner::Timings::Rebuild, ms);
+        logLine("[" + nowStamp() + "] CH: jerarquia reconstruida vertices=" + std::to_string(chIndex->n)
+            + " atajos=" + std::to_string(chIndex->shortcuts));
+    }
+
+    void TransportController::ensureCRP() {
+        auto start = std::chrono::steady_clock::now();
+        if (!crpPartition.has_value() || !crpPartition->validFor(graph)) {
+            crpPartition = AlgoFacade::partitionCRP(graph);
+            crpMetric = CRP::Metric{};
+            logLine("[" + nowStamp() + "] CRP: particion niveles=" + std::to_string(crpPartition->levels()));
+        }
+        if (crpMetric.validFor(graph)) return;
+        bool build = !crpMetric.ready; // particion nueva o primera customizacion
+        auto t0 = std::chrono::steady_clock::now();
+        int cells = AlgoFacade::customizeCRP(graph, *crpPartition, crpMetric);
+        planTimings.record(Engine::CRP, build ? QueryPlanner::Timings::Build : QueryPlanner::Timings::Rebuild, elapsedMs(start));
+        auto us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - t0).count();
+        std::ostringstream os; os << "[" << nowStamp() << "] CRP: celdas recalculadas=" << cells
+            << " ms=" << std::fixed << std::setprecision(3) << us / 1000.0;
+        logLine(os.str());
     }
 
     void TransportController::logLine(const std::string& line) const {
@@ -7,6 +7,7 @@
 #include "Graph.h"
 #include "Result.h"
 #include "AlgoFacade.h"
+#include "CompactAllPairs.h"
 
 namespace transport {
 
@@ -19,12 +20,54 @@ namespace transport {
         std::string reportesPath = "reportes.txt";
         std::string recorridosPath = "recorridos_rutas.txt";
         std::string accidentesPath = "accidentes.txt";
+        // A*: costo por unidad de distancia (x,y); <= 0 calibra con los pesos de las rutas
+        double astarCostPerDistance = 0.0;
+        // ALT: cantidad de landmarks y estrategia de seleccion
+        int altLandmarkCount = 8;
+        ALT::LandmarkStrategy altStrategy = ALT::LandmarkStrategy::Avoid;
         // estado en memoria
         BST<Station> stations;
         Graph graph;
 
-        // cache de Floyd (se invalida si cambia el grafo)
+        // todos-los-pares exacto (NxN double + NxN int); con allPairsCompactInMemory solo existe
+        // mientras se calcula o se actualiza por diferencias
         std::optional<FloydWarshall::AllPairs> floydCache;
+        // forma compacta que responde runFloyd/distance (costos exactos sumando sobre el grafo);
+        // si viene de allPairsCachePath queda mapeada, sin copia en memoria
+        std::optional<CompactAllPairs> floydCompact;
+        bool allPairsCompactInMemory = true;
+        // foto del grafo con la que se calculo la matriz (para actualizarla por diferencias)
+        std::optional<CsrGraph> floydBase;
+        // copia compacta en disco, reutilizada si el hash del grafo coincide ("" = no persistir).
+        // Opcional: conviene ponerla junto a rutasPath/cierresPath
+        std::string allPairsCachePath;
+        CompactAllPairs::Options allPairsCacheOptions;
+        // con mas vertices que esto no se arma NxN (no entra en memoria): runFloyd calcula filas bajo
+        // demanda (o usa hub labels si allPairsLazyRows = false) y distance usa hub labels
+        int allPairsMaxVertices = 4000;
+        std::optional<HubLabels::Index> hubLabels;
+        bool allPairsLazyRows = true;
+        size_t allPairsRowBudgetBytes = size_t(64) << 20;   // memoria para las filas bajo demanda (LRU)
+        std::optional<LazyAllPairs> lazyAllPairs;
+        // planificador: memoria maxima para un indice (NxN incluido; por encima se rechaza)
+        size_t memoryBudgetBytes = size_t(512) << 20;
+        // foto CSR para consultas de solo lectura (se reconstruye si cambia graph.version())
+        std::optional<CsrGraph> csrCache;
+        // estado de busqueda reutilizado por runBFS/runDijkstra/runPrim
+        SearchWorkspace workspace;
+        SearchWorkspace workspaceBack;   // lado destino del Dijkstra bidireccional
+        // heuristica geometrica de A* (se verifica al cargar y cuando cambia el grafo)
+        std::optional<GeoHeuristic> geoHeuristic;
+        // tablas de landmarks (solo se recalculan si algun camino pudo abaratarse)
+        std::optional<ALT::Index> altIndex;
+        // jerarquia CH: se reconstruye solo si cambia la topologia util (aristas nuevas o reabiertas,
+        // pesos menores); setClosed(true) y subidas de costo se resuelven en la consulta
+        std::optional<CH::Hierarchy> chIndex;
+        // CRP: la particion solo cambia si cambian los vertices; la metrica se recustomiza por celdas
+        std::optional<CRP::Partition> crpPartition;
+        CRP::Metric crpMetric;
+        // puentes y articulaciones de la red abierta (se recalcula si cambia graph.version())
+        std::optional<Biconnectivity::Report> cutsCache;
 
         TransportController();
 
@@ -37,7 +80,7 @@ namespace transport {
         bool reloadAccidents();
         bool addStation(int id, const std::string& name);
         bool removeStation(int id);
-        bool addRoute(int u, int v, double w) { graph.addEdge(u, v, w, false); invalidateAllPairs(); return true; }
+        bool addRoute(int u, int v, double w) { graph.addEdge(u, v, w, false); return true; }
         bool exportGraphSummary();
         bool removeEdge(int u, int v);
         bool setClosed(int u, int v, bool closed);
@@ -46,8 +89,27 @@ namespace transport {
         // consultas
         VisitResult   runBFS(int start);
         VisitResult   runDFS(int start);
+        BFS::Levels   runBFSLevels(int start);     // saltos (transbordos) a cada estacion
         PathResult    runDijkstra(int src, int dst);
+        PathResult    runAStar(int src, int dst);      // usa coordenadas de estaciones
+        PathResult    runALT(int src, int dst);        // usa landmarks (cache)
+        PathResult    runCH(int src, int dst);         // usa contraction hierarchy (cache)
+        PathResult    runCRP(int src, int dst);        // usa particion multinivel (cache)
         PathResult    runFloyd(int src, int dst);       // usa cache
+        std::vector<PathResult> runKShortest(int src, int dst, int k); // alternativas (Yen), de menor a mayor costo
+        double        distance(int src, int dst);       // solo costo, sin log (consultas masivas)
+        // matriz origen-destino sin log por par (una linea de resumen en reportes.txt)
+        DistanceTable::Table distanceTable(const std::vector<int>& sources, const std::vector<int>& targets, bool withPaths = false);
+        // fuente mas cercana para cada estacion; reporta el tamano de cada zona
+        NearestFacility::Partition nearestFacility(const std::vector<int>& sources);
+        // estaciones alcanzables con costo <= maxCost y a lo sumo maxHops tramos (< 0: sin limite)
+        Isochrone::Reach isochrone(int origin, double maxCost, int maxHops = -1);
+        std::vector<Isochrone::Reach> isochrones(const std::vector<int>& origins, double maxCost, int maxHops = -1);
+        const Biconnectivity::Report& networkCuts();    // cache por version del grafo
+        bool          closureSplitsNetwork(int u, int v); // cerrar u-v (todos sus tramos) desconecta la red
+        PathResult    route(int src, int dst);          // motor elegido por el planificador (ver r.plan)
+        bool          precomputeAllPairs();             // NxN por adelantado; false si excede memoryBudgetBytes
+        QueryPlanner::Plan planQuery(QueryPattern pattern, int src = -1); // solo decide (no ejecuta ni cuenta la consulta)
         MSTResult     runPrim(int start);
         MSTResult     runKruskal();
 
@@ -55,11 +117,31 @@ namespace transport {
         std::vector<Station> stationsOnPath(const std::vector<int>& path) const;
         std::vector<Station> stationsInOrder() const;   // para listas/reportes
         const Graph& getGraph() const { return graph; }
+        const CsrGraph& snapshot();                      // foto CSR al dia
 
     private:
         void invalidateAllPairs();       // invalida cache de Floyd
-        void ensureAllPairs();           // recalcula si falta
+        void ensureAllPairs();           // recalcula si falta; si el grafo cambio, actualiza por diferencias
+        void computeAllPairs();          // NxN desde cero: N Dijkstra si la red es rala, Floyd si no
+        PathResult allPairsPath(int src, int dst) const; // de floydCompact o floydCache (ensureAllPairs antes)
+        void ensureHubLabels();          // reconstruye las etiquetas si cambio el grafo
+        void ensureLazyAllPairs();       // crea el proveedor de filas bajo demanda y aplica el presupuesto
+        void ensureHeuristic();          // reconstruye/verifica la heuristica de A*
+        void ensureAlt();                // prepara/actualiza las tablas de ALT
+        void ensureCH();                 // reconstruye la jerarquia si cambio la topologia
+        void ensureCRP();                // particiona si falta y customiza las celdas cambiadas
+        bool matrixFits() const;         // NxN permitido por allPairsMaxVertices y memoryBudgetBytes
         void logLine(const std::string& line) const; // agrega a reportes.txt
+
+        // uso observado para el planificador
+        double planChurn = 0.0;          // fraccion reciente de consultas que encontraron el grafo cambiado
+        std::uint64_t planVersion = 0;
+        int planQueries = 0;
+        int planSinceChange = 0;         // consultas desde el ultimo cambio
+        int planLastSource = -1;
+        QueryPlanner::Timings planTimings; // construccion/consulta medidas de cada motor (ensure*, route)
+        bool planSawChange() const { return planQueries > 0 && planVersion != graph.version(); }
+        void notePlanQuery(int src);     // cuenta la consulta planificada en el uso observado
     };
 
 } // namespace transport
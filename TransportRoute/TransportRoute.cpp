@@ -216,8 +216,8 @@ void TransportRoute::onStationMoved(int id, double x, double y) {
 void TransportRoute::updateStatusBar() {
     auto stations = controller.stationsInOrder();
     int numRoutes = 0;
-    for (const auto& [u, edges] : controller.graph.data()) {
-        numRoutes += edges.size();
+    for (int s = 0; s < controller.graph.vertexCount(); ++s) {
+        numRoutes += controller.graph.neighborsAt(s).size();
     }
     numRoutes /= 2; // Grafo no dirigido
 